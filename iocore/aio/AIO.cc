@@ -47,6 +47,25 @@ static ink_mutex insert_mutex;
 
 int thread_is_created = 0;
 #endif // AIO_MODE == AIO_MODE_NATIVE
+
+#if AIO_MODE == AIO_MODE_IO_URING
+#define AIO_PERIOD -HRTIME_MSECONDS(10)
+#define MAX_AIO_EVENTS 1024
+#define MAX_FIXED_BUFFERS 256
+
+RecInt aio_io_uring_entries       = 1024;
+RecInt aio_io_uring_sq_poll_ms    = 0;
+RecInt aio_io_uring_fixed_buffers = 1;
+
+// buffers registered through ink_aio_register_buffer(), every ring picks
+// these up when aio_fixed_gen changes.
+static ink_mutex aio_fixed_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct iovec aio_fixed_buffers[MAX_FIXED_BUFFERS];
+static int aio_n_fixed_buffers = 0;
+static int aio_fixed_gen       = 0;
+#endif
+
+int ink_aio_mode                     = AIO_MODE;
 RecInt cache_config_threads_per_disk = 12;
 RecInt api_config_threads_per_disk   = 12;
 
@@ -142,6 +161,69 @@ ink_aio_set_callback(Continuation *callback)
   aio_err_callbck = callback;
 }
 
+const char *
+ink_aio_mode_name(int mode)
+{
+  switch (mode) {
+  case AIO_MODE_THREAD:
+    return "thread";
+  case AIO_MODE_NATIVE:
+    return "native";
+  case AIO_MODE_IO_URING:
+    return "io_uring";
+  default:
+    return "unknown";
+  }
+}
+
+bool
+ink_aio_mode_available(int mode)
+{
+#if AIO_MODE == AIO_MODE_NATIVE
+  return mode == AIO_MODE_NATIVE;
+#else
+  return mode == AIO_MODE_THREAD || mode == AIO_MODE;
+#endif
+}
+
+void
+ink_aio_register_buffer(void *buf, size_t len)
+{
+#if AIO_MODE == AIO_MODE_IO_URING
+  ink_mutex_acquire(&aio_fixed_mutex);
+  if (aio_n_fixed_buffers < MAX_FIXED_BUFFERS) {
+    aio_fixed_buffers[aio_n_fixed_buffers].iov_base = buf;
+    aio_fixed_buffers[aio_n_fixed_buffers].iov_len  = len;
+    ++aio_n_fixed_buffers;
+    ink_atomic_increment(&aio_fixed_gen, 1);
+  } else {
+    Debug("aio", "too many fixed buffers, %p will not be registered", buf);
+  }
+  ink_mutex_release(&aio_fixed_mutex);
+#else
+  (void)buf;
+  (void)len;
+#endif
+}
+
+void
+ink_aio_unregister_buffer(void *buf)
+{
+#if AIO_MODE == AIO_MODE_IO_URING
+  ink_mutex_acquire(&aio_fixed_mutex);
+  for (int i = 0; i < aio_n_fixed_buffers; ++i) {
+    if (aio_fixed_buffers[i].iov_base == buf) {
+      aio_fixed_buffers[i] = aio_fixed_buffers[--aio_n_fixed_buffers];
+      ink_atomic_increment(&aio_fixed_gen, 1);
+      break;
+    }
+  }
+  ink_mutex_release(&aio_fixed_mutex);
+#else
+  (void)buf;
+#endif
+}
+
 void
 ink_aio_init(ModuleVersion v)
 {
@@ -164,6 +246,23 @@ ink_aio_init(ModuleVersion v)
 #if TS_USE_LINUX_NATIVE_AIO
   Warning("Running with Linux AIO, there are known issues with this feature");
 #endif
+
+  int mode = -1;
+  REC_ReadConfigInteger(mode, "proxy.config.aio.mode");
+  if (ink_aio_mode_available(mode)) {
+    ink_aio_mode = mode;
+  } else if (mode >= 0) {
+    Warning("AIO mode %s is not available in this build, using %s", ink_aio_mode_name(mode), ink_aio_mode_name(ink_aio_mode));
+  }
+#if AIO_MODE == AIO_MODE_IO_URING
+  REC_ReadConfigInteger(aio_io_uring_entries, "proxy.config.aio.io_uring.entries");
+  REC_ReadConfigInteger(aio_io_uring_sq_poll_ms, "proxy.config.aio.io_uring.sq_poll_ms");
+  REC_ReadConfigInteger(aio_io_uring_fixed_buffers, "proxy.config.aio.io_uring.fixed_buffers");
+  if (ink_aio_mode == AIO_MODE_IO_URING) {
+    Warning("Running with Linux io_uring AIO, this feature is experimental");
+  }
+#endif
+  Debug("aio", "using the %s AIO engine", ink_aio_mode_name(ink_aio_mode));
 }
 
 int
@@ -418,10 +517,19 @@ cache_op(AIOCallbackInternal *op)
   return 1;
 }
 
+#if AIO_MODE == AIO_MODE_IO_URING
+static bool aio_uring_queue_req(AIOCallback *op);
+#endif
+
 int
 ink_aio_read(AIOCallback *op, int fromAPI)
 {
   op->aiocb.aio_lio_opcode = LIO_READ;
+#if AIO_MODE == AIO_MODE_IO_URING
+  if (!fromAPI && aio_uring_queue_req(op)) {
+    return 1;
+  }
+#endif
   aio_queue_req((AIOCallbackInternal *)op, fromAPI);
 
   return 1;
@@ -431,6 +539,11 @@ int
 ink_aio_write(AIOCallback *op, int fromAPI)
 {
   op->aiocb.aio_lio_opcode = LIO_WRITE;
+#if AIO_MODE == AIO_MODE_IO_URING
+  if (!fromAPI && aio_uring_queue_req(op)) {
+    return 1;
+  }
+#endif
   aio_queue_req((AIOCallbackInternal *)op, fromAPI);
 
   return 1;
@@ -504,6 +617,259 @@ aio_thread_main(void *arg)
   }
   return nullptr;
 }
+
+#if AIO_MODE == AIO_MODE_IO_URING
+/*
+ * io_uring
+ */
+
+DiskHandler::DiskHandler() : Continuation(nullptr)
+{
+  SET_HANDLER(&DiskHandler::startAIOEvent);
+  memset(&ring, 0, sizeof(ring));
+
+  struct io_uring_params p;
+  memset(&p, 0, sizeof(p));
+  if (aio_io_uring_sq_poll_ms > 0) {
+    p.flags |= IORING_SETUP_SQPOLL;
+    p.sq_thread_idle = aio_io_uring_sq_poll_ms;
+  }
+  int ret = io_uring_queue_init_params(aio_io_uring_entries, &ring, &p);
+  if (ret < 0 && (p.flags & IORING_SETUP_SQPOLL)) {
+    // SQPOLL requires privileges on older kernels, retry without it.
+    Warning("io_uring SQPOLL setup failed: %s (%d), disabling SQPOLL", strerror(-ret), -ret);
+    memset(&p, 0, sizeof(p));
+    ret = io_uring_queue_init_params(aio_io_uring_entries, &ring, &p);
+  }
+  if (ret < 0) {
+    Warning("io_uring setup failed: %s (%d), using AIO threads", strerror(-ret), -ret);
+    return;
+  }
+  valid         = true;
+  max_in_flight = p.cq_entries;
+}
+
+DiskHandler::~DiskHandler()
+{
+  if (valid) {
+    io_uring_queue_exit(&ring);
+  }
+  ats_free(fixed);
+}
+
+int
+DiskHandler::startAIOEvent(int /* event ATS_UNUSED */, Event *e)
+{
+  SET_HANDLER(&DiskHandler::mainAIOEvent);
+#ifdef HAVE_EVENTFD
+  if (valid) {
+    int ret = io_uring_register_eventfd(&ring, e->ethread->evfd);
+    if (ret < 0) {
+      Debug("aio", "io_uring_register_eventfd failed: %s (%d)", strerror(-ret), -ret);
+    }
+  }
+#endif
+  e->schedule_every(AIO_PERIOD);
+  trigger_event = e;
+  return EVENT_CONT;
+}
+
+void
+DiskHandler::update_fixed_buffers()
+{
+  // Buffers can only be re-registered when the ring is idle.
+  if (!aio_io_uring_fixed_buffers || fixed_gen == aio_fixed_gen || in_flight > 0) {
+    return;
+  }
+
+  ink_mutex_acquire(&aio_fixed_mutex);
+  int n = aio_n_fixed_buffers;
+  fixed = (struct iovec *)ats_realloc(fixed, sizeof(struct iovec) * (n ? n : 1));
+  memcpy(fixed, aio_fixed_buffers, sizeof(struct iovec) * n);
+  fixed_gen = aio_fixed_gen;
+  ink_mutex_release(&aio_fixed_mutex);
+
+  if (n_fixed > 0) {
+    io_uring_unregister_buffers(&ring);
+    n_fixed = 0;
+  }
+  if (n > 0) {
+    int ret = io_uring_register_buffers(&ring, fixed, n);
+    if (ret < 0) {
+      Debug("aio", "io_uring_register_buffers failed: %s (%d)", strerror(-ret), -ret);
+    } else {
+      n_fixed = n;
+    }
+  }
+}
+
+int
+DiskHandler::find_fixed_buffer(void *buf, size_t len)
+{
+  char *b = static_cast<char *>(buf);
+  for (int i = 0; i < n_fixed; ++i) {
+    char *base = static_cast<char *>(fixed[i].iov_base);
+    if (b >= base && b + len <= base + fixed[i].iov_len) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+void
+DiskHandler::submit()
+{
+  AIOCallback *op;
+  int num = 0;
+
+  while (in_flight < max_in_flight && (op = ready_list.dequeue()) != nullptr) {
+    struct io_uring_sqe *sqe = io_uring_get_sqe(&ring);
+    if (sqe == nullptr) {
+      // submission queue is full, flush it and try again.
+      io_uring_submit(&ring);
+      if ((sqe = io_uring_get_sqe(&ring)) == nullptr) {
+        ready_list.push(op);
+        break;
+      }
+    }
+
+    // aio_result holds the number of bytes already transferred for a
+    // request which completed short and was requeued.
+    ink_aiocb *a = &op->aiocb;
+    char *buf    = static_cast<char *>(a->aio_buf) + op->aio_result;
+    size_t len   = a->aio_nbytes - op->aio_result;
+    off_t offset = a->aio_offset + op->aio_result;
+    int idx      = find_fixed_buffer(buf, len);
+
+    if (a->aio_lio_opcode == LIO_READ) {
+      if (idx >= 0) {
+        io_uring_prep_read_fixed(sqe, a->aio_fildes, buf, len, offset, idx);
+      } else {
+        io_uring_prep_read(sqe, a->aio_fildes, buf, len, offset);
+      }
+      if (op->aio_result == 0) {
+        aio_num_read++;
+        aio_bytes_read += a->aio_nbytes;
+      }
+    } else {
+      if (idx >= 0) {
+        io_uring_prep_write_fixed(sqe, a->aio_fildes, buf, len, offset, idx);
+      } else {
+        io_uring_prep_write(sqe, a->aio_fildes, buf, len, offset);
+      }
+      if (op->aio_result == 0) {
+        aio_num_write++;
+        aio_bytes_written += a->aio_nbytes;
+      }
+    }
+    io_uring_sqe_set_data(sqe, op);
+    ++in_flight;
+    ++num;
+  }
+
+  if (num > 0) {
+    int ret = io_uring_submit(&ring);
+    if (ret < 0) {
+      Debug("aio", "io_uring_submit failed: %s (%d)", strerror(-ret), -ret);
+    }
+  }
+}
+
+void
+DiskHandler::reap()
+{
+  struct io_uring_cqe *cqes[MAX_AIO_EVENTS];
+  unsigned n;
+
+  while ((n = io_uring_peek_batch_cqe(&ring, cqes, MAX_AIO_EVENTS)) > 0) {
+    for (unsigned i = 0; i < n; ++i) {
+      AIOCallback *op = static_cast<AIOCallback *>(io_uring_cqe_get_data(cqes[i]));
+      int res         = cqes[i]->res;
+
+      --in_flight;
+      ink_assert(op->action.continuation);
+      if (res == -EAGAIN || res == -EINTR) {
+        ready_list.enqueue(op);
+      } else if (res <= 0) {
+        Warning("cache disk operation failed %s %d %d\n", (op->aiocb.aio_lio_opcode == LIO_READ) ? "READ" : "WRITE", res, -res);
+        if (res < 0) {
+          op->aio_result = res;
+        }
+        complete_list.enqueue(op);
+      } else {
+        op->aio_result += res;
+        if (op->aio_result < (int64_t)op->aiocb.aio_nbytes) {
+          ready_list.enqueue(op);
+        } else {
+          complete_list.enqueue(op);
+        }
+      }
+    }
+    io_uring_cq_advance(&ring, n);
+    if (n < MAX_AIO_EVENTS) {
+      break;
+    }
+  }
+}
+
+int
+DiskHandler::mainAIOEvent(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+{
+  AIOCallback *op = nullptr;
+
+  reap();
+  update_fixed_buffers();
+  submit();
+
+  while ((op = complete_list.dequeue()) != nullptr) {
+    op->mutex = op->action.mutex;
+    MUTEX_TRY_LOCK(lock, op->mutex, trigger_event->ethread);
+    if (!lock.is_locked()) {
+      trigger_event->ethread->schedule_imm(op);
+    } else {
+      op->handleEvent(EVENT_NONE, nullptr);
+    }
+  }
+  return EVENT_CONT;
+}
+
+/* Queue a request, or a chain of requests linked through AIOCallback::then,
+   on the ring of the calling thread. Returns false if the calling thread
+   has no ring, in which case the request goes to the AIO threads. */
+static bool
+aio_uring_queue_req(AIOCallback *op)
+{
+  if (ink_aio_mode != AIO_MODE_IO_URING) {
+    return false;
+  }
+
+  EThread *t      = this_ethread();
+  DiskHandler *dh = t ? t->diskHandler : nullptr;
+  if (dh == nullptr || !dh->valid) {
+    return false;
+  }
+
+  int sz = 0;
+  for (AIOCallback *io = op; io; io = io->then) {
+    io->aiocb.aio_lio_opcode = op->aiocb.aio_lio_opcode;
+    io->aio_result           = 0;
+    dh->ready_list.enqueue(io);
+    ++sz;
+  }
+
+  // Like the AIO threads, call back once with the first request when the
+  // whole chain has completed.
+  if (sz > 1) {
+    ink_assert(op->action.continuation);
+    AIOVec *vec = new AIOVec(sz, op);
+    while (--sz >= 0) {
+      op->action = vec;
+      op         = op->then;
+    }
+  }
+  return true;
+}
+#endif // AIO_MODE == AIO_MODE_IO_URING
 #else
 int
 DiskHandler::startAIOEvent(int /* event ATS_UNUSED */, Event *e)
@@ -42,9 +42,12 @@
 
 #define AIO_MODE_THREAD 0
 #define AIO_MODE_NATIVE 1
+#define AIO_MODE_IO_URING 2
 
 #if TS_USE_LINUX_NATIVE_AIO
 #define AIO_MODE AIO_MODE_NATIVE
+#elif TS_USE_LINUX_IO_URING
+#define AIO_MODE AIO_MODE_IO_URING
 #else
 #define AIO_MODE AIO_MODE_THREAD
 #endif
@@ -68,6 +71,10 @@ typedef struct io_event ink_io_event_t;
 
 #else
 
+#if AIO_MODE == AIO_MODE_IO_URING
+#include <liburing.h>
+#endif
+
 struct ink_aiocb {
   int aio_fildes    = 0;
   void *aio_buf     = nullptr; /* buffer location */
@@ -104,7 +111,7 @@ struct AIOCallback : public Continuation {
   AIOCallback() {}
 };
 
-#if AIO_MODE == AIO_MODE_NATIVE
+#if AIO_MODE == AIO_MODE_NATIVE || AIO_MODE == AIO_MODE_IO_URING
 
 struct AIOVec : public Continuation {
   Action action;
@@ -120,6 +127,9 @@ struct AIOVec : public Continuation {
 
   int mainEvent(int event, Event *e);
 };
+#endif
+
+#if AIO_MODE == AIO_MODE_NATIVE
 
 struct DiskHandler : public Continuation {
   Event *trigger_event;
@@ -139,8 +149,58 @@ struct DiskHandler : public Continuation {
     }
   }
 };
+
+#elif AIO_MODE == AIO_MODE_IO_URING
+
+/*
+  With io_uring each event thread owns a ring. Requests queued by
+  ink_aio_read/ink_aio_write during an event loop pass are collected on
+  ready_list and submitted with a single io_uring_submit() from
+  mainAIOEvent, which also reaps the completions. The ring eventfd is the
+  thread's own evfd, so completions wake the event loop.
+*/
+struct DiskHandler : public Continuation {
+  Event *trigger_event = nullptr;
+  struct io_uring ring;
+  bool valid          = false; // io_uring_queue_init() succeeded
+  int in_flight       = 0;     // submitted requests not yet reaped
+  int max_in_flight   = 0;     // size of the completion queue
+  int fixed_gen       = 0;     // generation of the registered fixed buffers
+  int n_fixed         = 0;     // number of buffers registered with this ring
+  struct iovec *fixed = nullptr;
+  Que(AIOCallback, link) ready_list;
+  Que(AIOCallback, link) complete_list;
+  int startAIOEvent(int event, Event *e);
+  int mainAIOEvent(int event, Event *e);
+  DiskHandler();
+  ~DiskHandler();
+
+private:
+  void update_fixed_buffers();
+  int find_fixed_buffer(void *buf, size_t len);
+  void submit();
+  void reap();
+};
 #endif
 
+/*
+  Run time selection of the AIO engine (proxy.config.aio.mode). The engine
+  is fixed in AIO_MODE_THREAD and AIO_MODE_NATIVE builds, AIO_MODE_IO_URING
+  builds can choose between the thread pool and io_uring.
+*/
+extern int ink_aio_mode;
+const char *ink_aio_mode_name(int mode);
+bool ink_aio_mode_available(int mode);
+
+/*
+  Register a long lived buffer (e.g. a Vol aggregation buffer) which is
+  used for many writes. The io_uring engine registers such buffers with
+  each ring as fixed buffers, avoiding page pinning on every request. This
+  is a no-op for the other engines.
+*/
+void ink_aio_register_buffer(void *buf, size_t len);
+void ink_aio_unregister_buffer(void *buf);
+
 void ink_aio_init(ModuleVersion version);
 int ink_aio_start();
 void ink_aio_set_callback(Continuation *error_callback);
@@ -72,6 +72,7 @@ int threads_per_disk = 1;
 int delete_disks     = 0;
 int max_size         = 0;
 int use_lseek        = 0;
+int aio_mode         = -1; // -1: engine compiled in, otherwise an AIO_MODE_* value
 
 int chains                    = 1;
 double seq_read_percent       = 0.0;
@@ -164,6 +165,7 @@ dump_summary()
   printf("%d disks\n", n_disk_path);
   printf("%d chains\n", chains);
   printf("%d threads_per_disk\n", threads_per_disk);
+  printf("%s aio engine\n", ink_aio_mode_name(ink_aio_mode));
 
   printf("%0.1f percent %d byte seq_reads by volume\n", seq_read_percent * 100.0, seq_read_size);
   printf("%0.1f percent %d byte seq_writes by volume\n", seq_write_percent * 100.0, seq_write_size);
@@ -376,6 +378,7 @@ read_config(const char *config_filename)
     PARAM(chains)
     PARAM(threads_per_disk)
     PARAM(delete_disks)
+    PARAM(aio_mode)
     else if (strcmp(field_name, "disk_path") == 0)
     {
       assert(n_disk_path < MAX_DISK_THREADS);
@@ -420,16 +423,6 @@ main(int /* argc ATS_UNUSED */, char *argv[])
   Thread *main_thread = new EThread;
   main_thread->set_specific();
 
-#if AIO_MODE == AIO_MODE_NATIVE
-  int etype            = ET_NET;
-  int n_netthreads     = eventProcessor.n_threads_for_type[etype];
-  EThread **netthreads = eventProcessor.eventthread[etype];
-  for (int i = 0; i < n_netthreads; ++i) {
-    netthreads[i]->diskHandler = new DiskHandler();
-    netthreads[i]->schedule_imm(netthreads[i]->diskHandler);
-  }
-#endif
-
   RecProcessStart();
   ink_aio_init(AIO_MODULE_VERSION);
   srand48(time(nullptr));
@@ -438,6 +431,28 @@ main(int /* argc ATS_UNUSED */, char *argv[])
     exit(1);
   }
 
+  // Run the same workload against each engine to compare them, the
+  // native engine is only available when built with it.
+  if (aio_mode >= 0) {
+    if (!ink_aio_mode_available(aio_mode)) {
+      printf("aio engine %s is not available in this build\n", ink_aio_mode_name(aio_mode));
+      exit(1);
+    }
+    ink_aio_mode = aio_mode;
+  }
+
+#if AIO_MODE == AIO_MODE_NATIVE || AIO_MODE == AIO_MODE_IO_URING
+  if (ink_aio_mode != AIO_MODE_THREAD) {
+    int etype            = ET_NET;
+    int n_netthreads     = eventProcessor.thread_group[etype]._count;
+    EThread **netthreads = eventProcessor.thread_group[etype]._thread;
+    for (int i = 0; i < n_netthreads; ++i) {
+      netthreads[i]->diskHandler = new DiskHandler();
+      netthreads[i]->schedule_imm(netthreads[i]->diskHandler);
+    }
+  }
+#endif
+
   max_size = seq_read_size;
   if (seq_write_size > max_size) {
     max_size = seq_write_size;
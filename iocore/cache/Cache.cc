@@ -36,6 +36,7 @@
 #include "P_CacheBC.h"
 
 #include "ts/hugepages.h"
+#include "ts/HashCRC32C.h"
 
 const VersionNumber CACHE_DB_VERSION(CACHE_DB_MAJOR_VERSION, CACHE_DB_MINOR_VERSION);
 
@@ -54,6 +55,8 @@ static short int const CACHE_DB_MAJOR_VERSION_COMPATIBLE = 21;
     RecSetRawStatCount(rsb, x, 0); \
   } while (0);
 
+#define ADMISSION_SKETCH_MAX_KEYS ((int64_t)1 << 20)
+
 // Configuration
 
 int64_t cache_config_ram_cache_size            = AUTO_SIZE_RAM_CACHE;
@@ -61,8 +64,18 @@ int cache_config_ram_cache_algorithm           = 1;
 int cache_config_ram_cache_compress            = 0;
 int cache_config_ram_cache_compress_percent    = 90;
 int cache_config_ram_cache_use_seen_filter     = 1;
+int cache_config_ram_cache_zstd_dict_size      = 0;
+int cache_config_ram_cache_persist_interval    = 0;
+int cache_config_ram_cache_warm_rate           = 100;
+int cache_config_tier_promote_hits             = 2;
+int cache_config_admission_enabled             = 0;
+int cache_config_admission_min_hits            = 2;
+int64_t cache_config_admission_large_size      = 1048576;
+int64_t cache_config_admission_write_budget    = 0;
 int cache_config_http_max_alts                 = 3;
 int cache_config_dir_sync_frequency            = 60;
+int cache_config_dir_sync_incremental          = 1;
+int cache_config_init_serve_partial            = 0;
 int cache_config_permit_pinning                = 0;
 int cache_config_select_alternate              = 1;
 int cache_config_max_doc_size                  = 0;
@@ -74,6 +87,7 @@ int cache_config_hit_evacuate_size_limit       = 0;
 int cache_config_force_sector_size             = 0;
 int cache_config_target_fragment_size          = DEFAULT_TARGET_FRAGMENT_SIZE;
 int cache_config_agg_write_backlog             = AGG_SIZE * 2;
+int cache_config_agg_write_buffers             = 2;
 int cache_config_enable_checksum               = 0;
 int cache_config_alt_rewrite_max_size          = 4096;
 int cache_config_read_while_writer             = 0;
@@ -117,6 +131,9 @@ struct VolInitInfo {
   off_t recover_pos;
   AIOCallbackInternal vol_aio[4];
   char *vol_h_f;
+  ink_hrtime start_time   = 0; // directory read started
+  ink_hrtime recover_time = 0; // recovery scan started
+  ink_hrtime clean_time   = 0; // clearing the unsynced range and writing the directory back started
 
   VolInitInfo()
   {
@@ -592,13 +609,15 @@ CacheProcessor::start_internal(int flags)
   ink_assert((int)TS_EVENT_CACHE_SCAN_OPERATION_FAILED == (int)CACHE_EVENT_SCAN_OPERATION_FAILED);
   ink_assert((int)TS_EVENT_CACHE_SCAN_DONE == (int)CACHE_EVENT_SCAN_DONE);
 
-#if AIO_MODE == AIO_MODE_NATIVE
-  int etype            = ET_NET;
-  int n_netthreads     = eventProcessor.n_threads_for_type[etype];
-  EThread **netthreads = eventProcessor.eventthread[etype];
-  for (int i = 0; i < n_netthreads; ++i) {
-    netthreads[i]->diskHandler = new DiskHandler();
-    netthreads[i]->schedule_imm(netthreads[i]->diskHandler);
+#if AIO_MODE == AIO_MODE_NATIVE || AIO_MODE == AIO_MODE_IO_URING
+  if (ink_aio_mode != AIO_MODE_THREAD) {
+    int etype            = ET_NET;
+    int n_netthreads     = eventProcessor.thread_group[etype]._count;
+    EThread **netthreads = eventProcessor.thread_group[etype]._thread;
+    for (int i = 0; i < n_netthreads; ++i) {
+      netthreads[i]->diskHandler = new DiskHandler();
+      netthreads[i]->schedule_imm(netthreads[i]->diskHandler);
+    }
   }
 #endif
 
@@ -863,6 +882,69 @@ CacheProcessor::diskInitialized()
   }
 }
 
+/* Give a stripe that finished loading its directory a RAM cache, sized in proportion to the disk space
+   the stripe occupies, and add its storage to the stats.
+ */
+static void
+vol_online(Vol *vol)
+{
+  ProxyMutex *mutex       = this_ethread()->mutex.get();
+  int64_t ram_cache_bytes = 0;
+
+  if (vol->header->version < cacheProcessor.min_stripe_version) {
+    cacheProcessor.min_stripe_version = vol->header->version;
+  }
+  if (cacheProcessor.max_stripe_version < vol->header->version) {
+    cacheProcessor.max_stripe_version = vol->header->version;
+  }
+
+  switch (cache_config_ram_cache_algorithm) {
+  default:
+  case RAM_CACHE_ALGORITHM_CLFUS:
+    vol->ram_cache = new_RamCacheCLFUS();
+    break;
+  case RAM_CACHE_ALGORITHM_LRU:
+    vol->ram_cache = new_RamCacheLRU();
+    break;
+  case RAM_CACHE_ALGORITHM_TINYLFU:
+    vol->ram_cache = new_RamCacheTinyLFU();
+    break;
+  }
+
+  if (cache_config_ram_cache_size == AUTO_SIZE_RAM_CACHE) {
+    vol->ram_cache->init(vol->dirlen() * DEFAULT_RAM_CACHE_MULTIPLIER, vol);
+    ram_cache_bytes = vol->dirlen();
+  } else {
+    ink_release_assert(vol->cache == theCache);
+    double factor   = (double)(int64_t)(vol->len >> STORE_BLOCK_SHIFT) / (int64_t)theCache->cache_size;
+    ram_cache_bytes = (int64_t)(cache_config_ram_cache_size * factor);
+    vol->ram_cache->init(ram_cache_bytes, vol);
+  }
+  Debug("cache_init", "Vol %s: ram_cache_bytes = %" PRId64 " = %" PRId64 "Mb", vol->hash_text.get(), ram_cache_bytes,
+        ram_cache_bytes / (1024 * 1024));
+  if (!CacheProcessor::check) {
+    start_ram_cache_warm(vol);
+  }
+
+  int64_t cache_bytes      = vol->len - vol->dirlen();
+  int64_t total_direntries = vol->buckets * vol->segments * DIR_DEPTH;
+  int64_t used_direntries  = dir_entries_used(vol);
+
+  if (cache_config_admission_enabled) {
+    // enough to tell the popular new objects apart, a sketch as large as the directory would not help
+    vol->admission_sketch.init(std::min(total_direntries, ADMISSION_SKETCH_MAX_KEYS));
+  }
+
+  CACHE_VOL_SUM_DYN_STAT(cache_ram_cache_bytes_total_stat, ram_cache_bytes);
+  CACHE_VOL_SUM_DYN_STAT(cache_bytes_total_stat, cache_bytes);
+  CACHE_VOL_SUM_DYN_STAT(cache_direntries_total_stat, total_direntries);
+  CACHE_VOL_SUM_DYN_STAT(cache_direntries_used_stat, used_direntries);
+  RecIncrGlobalRawStat(cache_rsb, cache_ram_cache_bytes_total_stat, ram_cache_bytes);
+  RecIncrGlobalRawStat(cache_rsb, cache_bytes_total_stat, cache_bytes);
+  RecIncrGlobalRawStat(cache_rsb, cache_direntries_total_stat, total_direntries);
+  RecIncrGlobalRawStat(cache_rsb, cache_direntries_used_stat, used_direntries);
+}
+
 void
 CacheProcessor::cacheInitialized()
 {
@@ -872,20 +954,9 @@ CacheProcessor::cacheInitialized()
     return;
   }
 
-  int caches_ready  = 0;
-  int cache_init_ok = 0;
-  /* allocate ram size in proportion to the disk space the
-     volume accupies */
-  int64_t total_size             = 0; // count in HTTP & MIXT
-  uint64_t total_cache_bytes     = 0; // bytes that can used in total_size
-  uint64_t total_direntries      = 0; // all the direntries in the cache
-  uint64_t used_direntries       = 0; //   and used
-  uint64_t vol_total_cache_bytes = 0;
-  uint64_t vol_total_direntries  = 0;
-  uint64_t vol_used_direntries   = 0;
-  Vol *vol;
-
-  ProxyMutex *mutex = this_ethread()->mutex.get();
+  int caches_ready   = 0;
+  int cache_init_ok  = 0;
+  int64_t total_size = 0; // count in HTTP & MIXT
 
   if (theCache) {
     total_size += theCache->cache_size;
@@ -902,112 +973,17 @@ CacheProcessor::cacheInitialized()
     }
   }
 
-  // Update stripe version data.
+  // Update stripe version data, vol_online() scans the rest of the stripes.
   if (gnvol) { // start with whatever the first stripe is.
     cacheProcessor.min_stripe_version = cacheProcessor.max_stripe_version = gvol[0]->header->version;
   }
-  // scan the rest of the stripes.
-  for (i = 1; i < gnvol; i++) {
-    Vol *v = gvol[i];
-    if (v->header->version < cacheProcessor.min_stripe_version) {
-      cacheProcessor.min_stripe_version = v->header->version;
-    }
-    if (cacheProcessor.max_stripe_version < v->header->version) {
-      cacheProcessor.max_stripe_version = v->header->version;
-    }
-  }
 
   if (caches_ready) {
     Debug("cache_init", "CacheProcessor::cacheInitialized - caches_ready=0x%0X, gnvol=%d", (unsigned int)caches_ready, gnvol);
 
-    int64_t ram_cache_bytes = 0;
-
     if (gnvol) {
-      // new ram_caches, with algorithm from the config
       for (i = 0; i < gnvol; i++) {
-        switch (cache_config_ram_cache_algorithm) {
-        default:
-        case RAM_CACHE_ALGORITHM_CLFUS:
-          gvol[i]->ram_cache = new_RamCacheCLFUS();
-          break;
-        case RAM_CACHE_ALGORITHM_LRU:
-          gvol[i]->ram_cache = new_RamCacheLRU();
-          break;
-        }
-      }
-      // let us calculate the Size
-      if (cache_config_ram_cache_size == AUTO_SIZE_RAM_CACHE) {
-        Debug("cache_init", "CacheProcessor::cacheInitialized - cache_config_ram_cache_size == AUTO_SIZE_RAM_CACHE");
-        for (i = 0; i < gnvol; i++) {
-          vol = gvol[i];
-          gvol[i]->ram_cache->init(vol->dirlen() * DEFAULT_RAM_CACHE_MULTIPLIER, vol);
-          ram_cache_bytes += gvol[i]->dirlen();
-          Debug("cache_init", "CacheProcessor::cacheInitialized - ram_cache_bytes = %" PRId64 " = %" PRId64 "Mb", ram_cache_bytes,
-                ram_cache_bytes / (1024 * 1024));
-          CACHE_VOL_SUM_DYN_STAT(cache_ram_cache_bytes_total_stat, (int64_t)gvol[i]->dirlen());
-
-          vol_total_cache_bytes = gvol[i]->len - gvol[i]->dirlen();
-          total_cache_bytes += vol_total_cache_bytes;
-          Debug("cache_init", "CacheProcessor::cacheInitialized - total_cache_bytes = %" PRId64 " = %" PRId64 "Mb",
-                total_cache_bytes, total_cache_bytes / (1024 * 1024));
-
-          CACHE_VOL_SUM_DYN_STAT(cache_bytes_total_stat, vol_total_cache_bytes);
-
-          vol_total_direntries = gvol[i]->buckets * gvol[i]->segments * DIR_DEPTH;
-          total_direntries += vol_total_direntries;
-          CACHE_VOL_SUM_DYN_STAT(cache_direntries_total_stat, vol_total_direntries);
-
-          vol_used_direntries = dir_entries_used(gvol[i]);
-          CACHE_VOL_SUM_DYN_STAT(cache_direntries_used_stat, vol_used_direntries);
-          used_direntries += vol_used_direntries;
-        }
-
-      } else {
-        // we got configured memory size
-        // TODO, should we check the available system memories, or you will
-        //   OOM or swapout, that is not a good situation for the server
-        Debug("cache_init", "CacheProcessor::cacheInitialized - %" PRId64 " != AUTO_SIZE_RAM_CACHE", cache_config_ram_cache_size);
-        int64_t http_ram_cache_size =
-          (theCache) ? (int64_t)(((double)theCache->cache_size / total_size) * cache_config_ram_cache_size) : 0;
-        Debug("cache_init", "CacheProcessor::cacheInitialized - http_ram_cache_size = %" PRId64 " = %" PRId64 "Mb",
-              http_ram_cache_size, http_ram_cache_size / (1024 * 1024));
-        int64_t stream_ram_cache_size = cache_config_ram_cache_size - http_ram_cache_size;
-        Debug("cache_init", "CacheProcessor::cacheInitialized - stream_ram_cache_size = %" PRId64 " = %" PRId64 "Mb",
-              stream_ram_cache_size, stream_ram_cache_size / (1024 * 1024));
-
-        // Dump some ram_cache size information in debug mode.
-        Debug("ram_cache", "config: size = %" PRId64 ", cutoff = %" PRId64 "", cache_config_ram_cache_size,
-              cache_config_ram_cache_cutoff);
-
-        for (i = 0; i < gnvol; i++) {
-          vol = gvol[i];
-          double factor;
-          if (gvol[i]->cache == theCache) {
-            ink_assert(gvol[i]->cache != nullptr);
-            factor = (double)(int64_t)(gvol[i]->len >> STORE_BLOCK_SHIFT) / (int64_t)theCache->cache_size;
-            Debug("cache_init", "CacheProcessor::cacheInitialized - factor = %f", factor);
-            gvol[i]->ram_cache->init((int64_t)(http_ram_cache_size * factor), vol);
-            ram_cache_bytes += (int64_t)(http_ram_cache_size * factor);
-            CACHE_VOL_SUM_DYN_STAT(cache_ram_cache_bytes_total_stat, (int64_t)(http_ram_cache_size * factor));
-          } else {
-            ink_release_assert(!"Unexpected non-HTTP cache volume");
-          }
-          Debug("cache_init", "CacheProcessor::cacheInitialized[%d] - ram_cache_bytes = %" PRId64 " = %" PRId64 "Mb", i,
-                ram_cache_bytes, ram_cache_bytes / (1024 * 1024));
-          vol_total_cache_bytes = gvol[i]->len - gvol[i]->dirlen();
-          total_cache_bytes += vol_total_cache_bytes;
-          CACHE_VOL_SUM_DYN_STAT(cache_bytes_total_stat, vol_total_cache_bytes);
-          Debug("cache_init", "CacheProcessor::cacheInitialized - total_cache_bytes = %" PRId64 " = %" PRId64 "Mb",
-                total_cache_bytes, total_cache_bytes / (1024 * 1024));
-
-          vol_total_direntries = gvol[i]->buckets * gvol[i]->segments * DIR_DEPTH;
-          total_direntries += vol_total_direntries;
-          CACHE_VOL_SUM_DYN_STAT(cache_direntries_total_stat, vol_total_direntries);
-
-          vol_used_direntries = dir_entries_used(gvol[i]);
-          CACHE_VOL_SUM_DYN_STAT(cache_direntries_used_stat, vol_used_direntries);
-          used_direntries += vol_used_direntries;
-        }
+        vol_online(gvol[i]);
       }
       switch (cache_config_ram_cache_compress) {
       default:
@@ -1023,16 +999,19 @@ CacheProcessor::cacheInitialized()
       case CACHE_COMPRESSION_LIBLZMA:
 #ifndef HAVE_LZMA_H
         Fatal("lzma not available for RAM cache compression");
+#endif
+        break;
+      case CACHE_COMPRESSION_ZSTD:
+#ifndef HAVE_ZSTD_H
+        Fatal("zstd not available for RAM cache compression");
 #endif
         break;
       }
 
-      GLOBAL_CACHE_SET_DYN_STAT(cache_ram_cache_bytes_total_stat, ram_cache_bytes);
-      GLOBAL_CACHE_SET_DYN_STAT(cache_bytes_total_stat, total_cache_bytes);
-      GLOBAL_CACHE_SET_DYN_STAT(cache_direntries_total_stat, total_direntries);
-      GLOBAL_CACHE_SET_DYN_STAT(cache_direntries_used_stat, used_direntries);
       if (!check) {
         dir_sync_init();
+        start_ram_cache_persist();
+        cache_tier_init();
       }
       cache_init_ok = 1;
     } else {
@@ -1292,14 +1271,31 @@ Vol::init(char *s, off_t blocks, off_t dir_skip, bool clear)
   header = (VolHeaderFooter *)raw_dir;
   footer = (VolHeaderFooter *)(raw_dir + this->dirlen() - ROUND_TO_STORE_BLOCK(sizeof(VolHeaderFooter)));
 
+  // nothing is known about what is on disk yet, the first sync of each copy writes all of it
+  segment_dirty = (uint8_t *)ats_malloc(segments);
+  mark_all_segments_dirty();
+
+  agg_buf_count = cache_config_agg_write_buffers;
+  agg_bufs      = new AggBuffer[agg_buf_count];
+  for (int i = 0; i < agg_buf_count; i++) {
+    AggBuffer *b = &agg_bufs[i];
+    b->vol       = this;
+    b->mutex     = mutex;
+    b->buffer    = (char *)ats_memalign(ats_pagesize(), AGG_SIZE);
+    memset(b->buffer, 0, AGG_SIZE);
+    ink_aio_register_buffer(b->buffer, AGG_SIZE);
+  }
+  agg_buffer = agg_bufs[0].buffer;
+
   if (clear) {
     Note("clearing cache directory '%s'", hash_text.get());
     return clear_dir();
   }
 
-  init_info           = new VolInitInfo();
-  int footerlen       = ROUND_TO_STORE_BLOCK(sizeof(VolHeaderFooter));
-  off_t footer_offset = this->dirlen() - footerlen;
+  init_info             = new VolInitInfo();
+  init_info->start_time = Thread::get_hrtime_updated();
+  int footerlen         = ROUND_TO_STORE_BLOCK(sizeof(VolHeaderFooter));
+  off_t footer_offset   = this->dirlen() - footerlen;
   // try A
   off_t as = skip;
 
@@ -1385,7 +1381,8 @@ Vol::handle_dir_read(int event, void *data)
   }
   CHECK_DIR(this);
 
-  sector_size = header->sector_size;
+  sector_size             = header->sector_size;
+  init_info->recover_time = Thread::get_hrtime_updated();
 
   return this->recover_data();
 
@@ -1617,6 +1614,8 @@ Vol::handle_recover_from_data(int event, void * /* data ATS_UNUSED */)
   return EVENT_CONT;
 
 Ldone : {
+  init_info->clean_time = Thread::get_hrtime_updated();
+
   /* if we come back to the starting position, then we don't have to recover anything */
   if (recover_pos == header->write_pos && recover_wrapped) {
     SET_HANDLER(&Vol::handle_recover_write_dir);
@@ -1702,10 +1701,26 @@ Vol::handle_recover_write_dir(int /* event ATS_UNUSED */, void * /* data ATS_UNU
   if (io.aiocb.aio_buf) {
     free((char *)io.aiocb.aio_buf);
   }
+
+  Vol *vol       = this; // must be named "vol" to make STAT macros work.
+  ink_hrtime now = Thread::get_hrtime_updated();
+  if (!init_info->clean_time) { // a new directory, there was nothing to scan
+    init_info->clean_time = now;
+  }
+  ink_hrtime read_time    = init_info->recover_time - init_info->start_time;
+  ink_hrtime recover_time = init_info->clean_time - init_info->recover_time;
+  ink_hrtime clean_time   = now - init_info->clean_time;
+  CACHE_SUM_DYN_STAT(cache_init_dir_read_time_stat, read_time);
+  CACHE_SUM_DYN_STAT(cache_init_recover_time_stat, recover_time);
+  CACHE_SUM_DYN_STAT(cache_init_clean_time_stat, clean_time);
+  Debug("cache_init", "Vol %s: directory read %.3f sec, recovery scan %.3f sec, clean %.3f sec", hash_text.get(),
+        (double)read_time / HRTIME_SECOND, (double)recover_time / HRTIME_SECOND, (double)clean_time / HRTIME_SECOND);
+
   delete init_info;
   init_info = nullptr;
   set_io_not_in_progress();
-  scan_pos = header->write_pos;
+  header->agg_pos = header->write_pos; // nothing is in flight, aggregation starts at the write position
+  scan_pos        = header->write_pos;
   periodic_scan();
   SET_HANDLER(&Vol::dir_init_done);
   return dir_init_done(EVENT_IMMEDIATE, nullptr);
@@ -1776,15 +1791,8 @@ Vol::dir_init_done(int /* event ATS_UNUSED */, void * /* data ATS_UNUSED */)
     eventProcessor.schedule_in(this, HRTIME_MSECONDS(5), ET_CALL);
     return EVENT_CONT;
   } else {
-    int vol_no = ink_atomic_increment(&gnvol, 1);
-    ink_assert(!gvol[vol_no]);
-    gvol[vol_no] = this;
     SET_HANDLER(&Vol::aggWrite);
-    if (fd == -1) {
-      cache->vol_initialized(false);
-    } else {
-      cache->vol_initialized(true);
-    }
+    cache->vol_initialized(this, fd != -1);
     return EVENT_DONE;
   }
 }
@@ -1826,7 +1834,7 @@ build_vol_hash_table(CacheHostRecord *cp)
   uint64_t used  = 0;
   // initialize number of elements per vol
   for (int i = 0; i < num_vols; i++) {
-    if (DISK_BAD(cp->vols[i]->disk)) {
+    if (DISK_BAD(cp->vols[i]->disk) || !cp->vols[i]->ready) {
       bad_vols++;
       continue;
     }
@@ -1920,13 +1928,39 @@ build_vol_hash_table(CacheHostRecord *cp)
 }
 
 void
-Cache::vol_initialized(bool result)
+Cache::vol_initialized(Vol *vol, bool result)
 {
+  ink_scoped_mutex_lock lock(vol_init_mutex);
+
+  // The dir sync and the stats walk gvol while the late stripes of a partial start are still coming up,
+  // so fill in the slot before counting it.
+  ink_assert(!gvol[gnvol]);
+  gvol[gnvol] = vol;
+  ink_atomic_increment(&gnvol, 1);
+
+  vol->ready = result;
   if (result) {
-    ink_atomic_increment(&total_good_nvol, 1);
+    ++total_good_nvol;
   }
-  if (total_nvol == ink_atomic_increment(&total_initialized_vol, 1) + 1) {
-    open_done();
+  ++total_initialized_vol;
+
+  if (ready == CACHE_INITIALIZING) {
+    if (total_initialized_vol == total_nvol || (result && cache_config_init_serve_partial)) {
+      if (total_initialized_vol < total_nvol) {
+        Note("cache stripe '%s' ready, serving from %d of %d stripes until the rest are loaded", vol->hash_text.get(),
+             total_good_nvol, total_nvol);
+      }
+      open_done();
+    }
+  } else if (ready == CACHE_INITIALIZED) {
+    // a partial start, the stripe joins the ones already serving
+    if (result) {
+      vol_online(vol);
+      rebuild_host_table(this);
+    }
+    if (total_initialized_vol == total_nvol) {
+      Note("cache stripes loaded, %d of %d ready", total_good_nvol, total_nvol);
+    }
   }
 }
 
@@ -2248,6 +2282,27 @@ upgrade_doc_version(Ptr<IOBufferData> &buf)
   return zret;
 }
 
+// Checksum of everything after the Doc header, in the form the doc was written with.
+uint32_t
+Doc::compute_checksum()
+{
+  char *b   = hdr();
+  char *end = reinterpret_cast<char *>(this) + len;
+
+  if (VersionNumber(v_major, v_minor) < VersionNumber(CACHE_DB_MAJOR_VERSION, DOC_CRC32C_MINOR_VERSION)) {
+    uint32_t sum = 0;
+    for (; b < end; b++) {
+      sum += *b;
+    }
+    return sum;
+  }
+
+  ATSHash32CRC32C crc;
+  crc.update(b, end - b);
+  crc.final();
+  return crc.get();
+}
+
 // [amc] I think this is where all disk reads from cache funnel through here.
 int
 CacheVC::handleReadDone(int event, Event *e)
@@ -2266,6 +2321,25 @@ CacheVC::handleReadDone(int event, Event *e)
     if (!lock.is_locked()) {
       VC_SCHED_LOCK_RETRY();
     }
+    if (f.doc_from_tier) {
+      // the copy may have been demoted and overwritten while it was read, if so read the volume
+      int64_t tier_offset;
+      uint32_t tier_len;
+      Doc *tier_doc   = reinterpret_cast<Doc *>(buf->data());
+      f.doc_from_tier = 0;
+      if (!io.ok() || !cache_tier->lookup(vol, read_key, &dir, tier_offset, tier_len) ||
+          tier_offset != (int64_t)io.aiocb.aio_offset || tier_doc->magic != DOC_MAGIC ||
+          (tier_doc->first_key != *read_key && tier_doc->key != *read_key)) {
+        CACHE_INCREMENT_DYN_STAT(cache_tier_read_failure_stat);
+        f.tier_bypass       = 1;
+        io.aiocb.aio_nbytes = dir_approx_size(&dir);
+        int ret             = handleRead(EVENT_CALL, nullptr);
+        if (ret == EVENT_RETURN) {
+          return handleEvent(AIO_EVENT_DONE, nullptr);
+        }
+        return ret;
+      }
+    }
     if ((!dir_valid(vol, &dir)) || (!io.ok())) {
       if (!io.ok()) {
         Debug("cache_disk_error", "Read error on disk %s\n \
@@ -2337,14 +2411,12 @@ CacheVC::handleReadDone(int event, Event *e)
       if (!f.doc_from_ram_cache) {
         f.not_from_ram_cache = 1;
       }
-      if (cache_config_enable_checksum && doc->checksum != DOC_NO_CHECKSUM) {
+      if (cache_config_enable_checksum && !f.doc_from_ram_cache && doc->checksum != DOC_NO_CHECKSUM) {
         // verify that the checksum matches
-        uint32_t checksum = 0;
-        for (char *b = doc->hdr(); b < (char *)doc + doc->len; b++) {
-          checksum += *b;
-        }
+        uint32_t checksum = doc->compute_checksum();
         ink_assert(checksum == doc->checksum);
         if (checksum != doc->checksum) {
+          CACHE_INCREMENT_DYN_STAT(cache_checksum_failure_stat);
           Note("cache: checksum error for [%" PRIu64 " %" PRIu64 "] len %d, hlen %d, disk %s, offset %" PRIu64 " size %zu",
                doc->first_key.b[0], doc->first_key.b[1], doc->len, doc->hlen, vol->path, (uint64_t)io.aiocb.aio_offset,
                (size_t)io.aiocb.aio_nbytes);
@@ -2352,6 +2424,10 @@ CacheVC::handleReadDone(int event, Event *e)
           okay       = 0;
         }
       }
+      // count the read and copy the fragment to the fast tier if it is popular, before the headers are unmarshalled
+      if (cache_tier && okay && !f.doc_from_ram_cache && vio.op == VIO::READ) {
+        cache_tier->promote(vol, read_key, &dir, doc);
+      }
       (void)e; // Avoid compiler warnings
       bool http_copy_hdr = false;
       http_copy_hdr =
@@ -2402,10 +2478,14 @@ CacheVC::handleRead(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
   cancel_trigger();
 
   f.doc_from_ram_cache = false;
+  bool tier_bypass     = f.tier_bypass;
+  f.tier_bypass        = 0;
 
   // check ram cache
   ink_assert(vol->mutex->thread_holding == this_ethread());
   int64_t o           = dir_offset(&dir);
+  int64_t tier_offset = 0;
+  uint32_t tier_len   = 0;
   int ram_hit_state   = vol->ram_cache->get(read_key, &buf, (uint32_t)(o >> 32), (uint32_t)o);
   f.compressed_in_ram = (ram_hit_state > RAM_HIT_COMPRESS_NONE) ? 1 : 0;
   if (ram_hit_state >= RAM_HIT_COMPRESS_NONE) {
@@ -2419,21 +2499,33 @@ CacheVC::handleRead(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
   }
   // see if its in the aggregation buffer
   if (dir_agg_buf_valid(vol, &dir)) {
-    int agg_offset = vol->vol_offset(&dir) - vol->header->write_pos;
-    buf            = new_IOBufferData(iobuffer_size_to_index(io.aiocb.aio_nbytes, MAX_BUFFER_SIZE_INDEX), MEMALIGNED);
-    ink_assert((agg_offset + io.aiocb.aio_nbytes) <= (unsigned)vol->agg_buf_pos);
+    off_t agg_offset = vol->vol_offset(&dir);
+    buf              = new_IOBufferData(iobuffer_size_to_index(io.aiocb.aio_nbytes, MAX_BUFFER_SIZE_INDEX), MEMALIGNED);
+    ink_assert((off_t)(agg_offset + io.aiocb.aio_nbytes) <= vol->header->agg_pos + vol->agg_buf_pos);
     char *doc = buf->data();
-    char *agg = vol->agg_buffer + agg_offset;
+    char *agg = vol->agg_buffer_at(agg_offset);
     memcpy(doc, agg, io.aiocb.aio_nbytes);
     io.aio_result = io.aiocb.aio_nbytes;
     SET_HANDLER(&CacheVC::handleReadDone);
     return EVENT_RETURN;
   }
 
-  io.aiocb.aio_fildes = vol->fd;
-  io.aiocb.aio_offset = vol->vol_offset(&dir);
-  if ((off_t)(io.aiocb.aio_offset + io.aiocb.aio_nbytes) > (off_t)(vol->skip + vol->len)) {
-    io.aiocb.aio_nbytes = vol->skip + vol->len - io.aiocb.aio_offset;
+  // see if the fast tier has a copy
+  if (cache_tier && !tier_bypass && cache_tier->lookup(vol, read_key, &dir, tier_offset, tier_len)) {
+    CACHE_INCREMENT_DYN_STAT(cache_tier_fast_hits_stat);
+    f.doc_from_tier     = 1;
+    io.aiocb.aio_fildes = cache_tier->fd;
+    io.aiocb.aio_offset = tier_offset;
+    io.aiocb.aio_nbytes = tier_len;
+  } else {
+    if (cache_tier) {
+      CACHE_INCREMENT_DYN_STAT(cache_tier_slow_hits_stat);
+    }
+    io.aiocb.aio_fildes = vol->fd;
+    io.aiocb.aio_offset = vol->vol_offset(&dir);
+    if ((off_t)(io.aiocb.aio_offset + io.aiocb.aio_nbytes) > (off_t)(vol->skip + vol->len)) {
+      io.aiocb.aio_nbytes = vol->skip + vol->len - io.aiocb.aio_offset;
+    }
   }
   buf              = new_IOBufferData(iobuffer_size_to_index(io.aiocb.aio_nbytes, MAX_BUFFER_SIZE_INDEX), MEMALIGNED);
   io.aiocb.aio_buf = buf->data();
@@ -2468,7 +2560,12 @@ Cache::lookup(Continuation *cont, const CacheKey *key, CacheFragType type, const
     return ACTION_RESULT_DONE;
   }
 
-  Vol *vol          = key_to_vol(key, hostname, host_len);
+  Vol *vol = key_to_vol(key, hostname, host_len);
+  if (!vol) {
+    cont->handleEvent(CACHE_EVENT_LOOKUP_FAILED, nullptr);
+    return ACTION_RESULT_DONE;
+  }
+
   ProxyMutex *mutex = cont->mutex.get();
   CacheVC *c        = new_CacheVC(cont);
   SET_CONTINUATION_HANDLER(c, &CacheVC::openReadStartHead);
@@ -2580,6 +2677,14 @@ Cache::remove(Continuation *cont, const CacheKey *key, CacheFragType type, const
     return ACTION_RESULT_DONE;
   }
 
+  Vol *vol = key_to_vol(key, hostname, host_len);
+  if (!vol) {
+    if (cont) {
+      cont->handleEvent(CACHE_EVENT_REMOVE_FAILED, nullptr);
+    }
+    return ACTION_RESULT_DONE;
+  }
+
   Ptr<ProxyMutex> mutex;
   if (!cont) {
     cont = new_CacheRemoveCont();
@@ -2587,7 +2692,6 @@ Cache::remove(Continuation *cont, const CacheKey *key, CacheFragType type, const
 
   CACHE_TRY_LOCK(lock, cont->mutex, this_ethread());
   ink_assert(lock.is_locked());
-  Vol *vol = key_to_vol(key, hostname, host_len);
   // coverity[var_decl]
   Dir result;
   dir_clear(&result); // initialized here, set result empty so we can recognize missed lock
@@ -3056,6 +3160,7 @@ rebuild_host_table(Cache *cache)
 }
 
 // if generic_host_rec.vols == nullptr, what do we do???
+// Returns nullptr when no stripe can take requests, the callers fail the operation like a miss.
 Vol *
 Cache::key_to_vol(const CacheKey *key, const char *hostname, int host_len)
 {
@@ -3085,9 +3190,15 @@ Cache::key_to_vol(const CacheKey *key, const char *hostname, int host_len)
       Debug("cache_hosting", format_str, host_rec, hostname);
     }
     return host_rec->vols[hash_table[h]];
-  } else {
-    return host_rec->vols[0];
   }
+  // No stripe can take requests yet, or all of their disks are bad. Any stripe
+  // that is ready is still better than a miss, one that isn't must not be used.
+  for (int i = 0; i < host_rec->num_vols; i++) {
+    if (host_rec->vols[i]->ready) {
+      return host_rec->vols[i];
+    }
+  }
+  return nullptr;
 }
 
 static void
@@ -3112,6 +3223,42 @@ register_cache_stats(RecRawStatBlock *rsb, const char *prefix)
   REG_INT("ram_cache.bytes_used", cache_ram_cache_bytes_stat);
   REG_INT("ram_cache.hits", cache_ram_cache_hits_stat);
   REG_INT("ram_cache.misses", cache_ram_cache_misses_stat);
+  REG_INT("ram_cache.fastlz.bytes_in", cache_ram_cache_fastlz_bytes_in_stat);
+  REG_INT("ram_cache.fastlz.bytes_out", cache_ram_cache_fastlz_bytes_out_stat);
+  REG_INT("ram_cache.fastlz.compress_time", cache_ram_cache_fastlz_compress_time_stat);
+  REG_INT("ram_cache.fastlz.hits", cache_ram_cache_fastlz_hits_stat);
+  REG_INT("ram_cache.fastlz.decompress_time", cache_ram_cache_fastlz_decompress_time_stat);
+  REG_INT("ram_cache.libz.bytes_in", cache_ram_cache_libz_bytes_in_stat);
+  REG_INT("ram_cache.libz.bytes_out", cache_ram_cache_libz_bytes_out_stat);
+  REG_INT("ram_cache.libz.compress_time", cache_ram_cache_libz_compress_time_stat);
+  REG_INT("ram_cache.libz.hits", cache_ram_cache_libz_hits_stat);
+  REG_INT("ram_cache.libz.decompress_time", cache_ram_cache_libz_decompress_time_stat);
+  REG_INT("ram_cache.liblzma.bytes_in", cache_ram_cache_liblzma_bytes_in_stat);
+  REG_INT("ram_cache.liblzma.bytes_out", cache_ram_cache_liblzma_bytes_out_stat);
+  REG_INT("ram_cache.liblzma.compress_time", cache_ram_cache_liblzma_compress_time_stat);
+  REG_INT("ram_cache.liblzma.hits", cache_ram_cache_liblzma_hits_stat);
+  REG_INT("ram_cache.liblzma.decompress_time", cache_ram_cache_liblzma_decompress_time_stat);
+  REG_INT("ram_cache.zstd.bytes_in", cache_ram_cache_zstd_bytes_in_stat);
+  REG_INT("ram_cache.zstd.bytes_out", cache_ram_cache_zstd_bytes_out_stat);
+  REG_INT("ram_cache.zstd.compress_time", cache_ram_cache_zstd_compress_time_stat);
+  REG_INT("ram_cache.zstd.hits", cache_ram_cache_zstd_hits_stat);
+  REG_INT("ram_cache.zstd.decompress_time", cache_ram_cache_zstd_decompress_time_stat);
+  REG_INT("ram_cache.warm.active", cache_ram_cache_warm_active_stat);
+  REG_INT("ram_cache.warm.success", cache_ram_cache_warm_success_stat);
+  REG_INT("ram_cache.warm.failure", cache_ram_cache_warm_failure_stat);
+  REG_INT("ram_cache.warm.pending", cache_ram_cache_warm_pending_stat);
+  REG_INT("tier.fast.hits", cache_tier_fast_hits_stat);
+  REG_INT("tier.slow.hits", cache_tier_slow_hits_stat);
+  REG_INT("tier.promote.success", cache_tier_promote_success_stat);
+  REG_INT("tier.promote.failure", cache_tier_promote_failure_stat);
+  REG_INT("tier.demote", cache_tier_demote_stat);
+  REG_INT("tier.read_failure", cache_tier_read_failure_stat);
+  REG_INT("tier.bytes_used", cache_tier_bytes_used_stat);
+  REG_INT("tier.total_bytes", cache_tier_bytes_total_stat);
+  REG_INT("admission.admitted", cache_admission_admitted_stat);
+  REG_INT("admission.admitted_bytes", cache_admission_admitted_bytes_stat);
+  REG_INT("admission.rejected", cache_admission_rejected_stat);
+  REG_INT("admission.rejected_bytes", cache_admission_rejected_bytes_stat);
   REG_INT("pread_count", cache_pread_count_stat);
   REG_INT("percent_full", cache_percent_full_stat);
   REG_INT("lookup.active", cache_lookup_active_stat);
@@ -3154,6 +3301,18 @@ register_cache_stats(RecRawStatBlock *rsb, const char *prefix)
   REG_INT("sync.count", cache_directory_sync_count_stat);
   REG_INT("sync.bytes", cache_directory_sync_bytes_stat);
   REG_INT("sync.time", cache_directory_sync_time_stat);
+  REG_INT("sync.segments_written", cache_directory_sync_segments_written_stat);
+  REG_INT("sync.segments_skipped", cache_directory_sync_segments_skipped_stat);
+  REG_INT("init.dir_read.time", cache_init_dir_read_time_stat);
+  REG_INT("init.recover.time", cache_init_recover_time_stat);
+  REG_INT("init.clean.time", cache_init_clean_time_stat);
+  REG_INT("agg_wait.1ms", cache_agg_wait_1ms_stat);
+  REG_INT("agg_wait.10ms", cache_agg_wait_10ms_stat);
+  REG_INT("agg_wait.100ms", cache_agg_wait_100ms_stat);
+  REG_INT("agg_wait.1s", cache_agg_wait_1s_stat);
+  REG_INT("agg_wait.inf", cache_agg_wait_inf_stat);
+  REG_INT("agg_wait.time", cache_agg_wait_time_stat);
+  REG_INT("checksum.failure", cache_checksum_failure_stat);
   REG_INT("span.errors.read", cache_span_errors_read_stat);
   REG_INT("span.errors.write", cache_span_errors_write_stat);
   REG_INT("span.failing", cache_span_failing_stat);
@@ -3176,6 +3335,14 @@ ink_cache_init(ModuleVersion v)
   REC_EstablishStaticConfigInt32(cache_config_ram_cache_compress, "proxy.config.cache.ram_cache.compress");
   REC_EstablishStaticConfigInt32(cache_config_ram_cache_compress_percent, "proxy.config.cache.ram_cache.compress_percent");
   REC_ReadConfigInt32(cache_config_ram_cache_use_seen_filter, "proxy.config.cache.ram_cache.use_seen_filter");
+  REC_EstablishStaticConfigInt32(cache_config_ram_cache_zstd_dict_size, "proxy.config.cache.ram_cache.zstd_dictionary_size");
+  REC_EstablishStaticConfigInt32(cache_config_ram_cache_persist_interval, "proxy.config.cache.ram_cache.persist_interval");
+  REC_EstablishStaticConfigInt32(cache_config_ram_cache_warm_rate, "proxy.config.cache.ram_cache.warm_rate");
+  REC_EstablishStaticConfigInt32(cache_config_tier_promote_hits, "proxy.config.cache.tier.promote_hits");
+  REC_EstablishStaticConfigInt32(cache_config_admission_enabled, "proxy.config.cache.admission.enabled");
+  REC_EstablishStaticConfigInt32(cache_config_admission_min_hits, "proxy.config.cache.admission.min_hits");
+  REC_EstablishStaticConfigInteger(cache_config_admission_large_size, "proxy.config.cache.admission.large_object_size");
+  REC_EstablishStaticConfigInteger(cache_config_admission_write_budget, "proxy.config.cache.admission.write_budget");
 
   REC_EstablishStaticConfigInt32(cache_config_http_max_alts, "proxy.config.cache.limits.http.max_alts");
   Debug("cache_init", "proxy.config.cache.limits.http.max_alts = %d", cache_config_http_max_alts);
@@ -3190,6 +3357,12 @@ ink_cache_init(ModuleVersion v)
   REC_EstablishStaticConfigInt32(cache_config_dir_sync_frequency, "proxy.config.cache.dir.sync_frequency");
   Debug("cache_init", "proxy.config.cache.dir.sync_frequency = %d", cache_config_dir_sync_frequency);
 
+  REC_EstablishStaticConfigInt32(cache_config_dir_sync_incremental, "proxy.config.cache.dir.sync_incremental");
+  Debug("cache_init", "proxy.config.cache.dir.sync_incremental = %d", cache_config_dir_sync_incremental);
+
+  REC_ReadConfigInteger(cache_config_init_serve_partial, "proxy.config.cache.init.serve_partial");
+  Debug("cache_init", "proxy.config.cache.init.serve_partial = %d", cache_config_init_serve_partial);
+
   REC_EstablishStaticConfigInt32(cache_config_select_alternate, "proxy.config.cache.select_alternate");
   Debug("cache_init", "proxy.config.cache.select_alternate = %d", cache_config_select_alternate);
 
@@ -3229,6 +3402,14 @@ ink_cache_init(ModuleVersion v)
   REC_EstablishStaticConfigInt32(cache_config_agg_write_backlog, "proxy.config.cache.agg_write_backlog");
   Debug("cache_init", "proxy.config.cache.agg_write_backlog = %d", cache_config_agg_write_backlog);
 
+  REC_ReadConfigInteger(cache_config_agg_write_buffers, "proxy.config.cache.agg_write_buffers");
+  if (cache_config_agg_write_buffers < 1) {
+    cache_config_agg_write_buffers = 1;
+  } else if (cache_config_agg_write_buffers > AGG_MAX_BUFFERS) {
+    cache_config_agg_write_buffers = AGG_MAX_BUFFERS;
+  }
+  Debug("cache_init", "proxy.config.cache.agg_write_buffers = %d", cache_config_agg_write_buffers);
+
   REC_EstablishStaticConfigInt32(cache_config_enable_checksum, "proxy.config.cache.enable_checksum");
   Debug("cache_init", "proxy.config.cache.enable_checksum = %d", cache_config_enable_checksum);
 
@@ -217,6 +217,7 @@ dir_init_segment(int s, Vol *d)
   d->header->freelist[s] = 0;
   Dir *seg               = d->dir_segment(s);
   int l, b;
+  d->mark_segment_dirty(s);
   memset(static_cast<void *>(seg), 0, SIZEOF_DIR * DIR_DEPTH * d->buckets);
   for (l = 1; l < DIR_DEPTH; l++) {
     for (b = 0; b < d->buckets; b++) {
@@ -312,6 +313,7 @@ unlink_from_freelist(Dir *e, int s, Vol *d)
   if (n) {
     dir_set_prev(n, dir_prev(e));
   }
+  d->mark_segment_dirty(s);
 }
 
 inline Dir *
@@ -321,6 +323,7 @@ dir_delete_entry(Dir *e, Dir *p, int s, Vol *d)
   int no           = dir_next(e);
   d->header->dirty = 1;
   if (p) {
+    d->mark_segment_dirty(s);
     unsigned int fo = d->header->freelist[s];
     unsigned int eo = dir_to_offset(e, seg);
     dir_clear(e);
@@ -337,6 +340,10 @@ dir_delete_entry(Dir *e, Dir *p, int s, Vol *d)
       dir_delete_entry(n, e, s, d);
       return e;
     } else {
+      // cleaning an already empty bucket head does not change the segment
+      if (dir_offset(e)) {
+        d->mark_segment_dirty(s);
+      }
       dir_clear(e);
       return nullptr;
     }
@@ -403,6 +410,7 @@ dir_clear_range(off_t start, off_t end, Vol *vol)
     if (!dir_token(e) && dir_offset(e) >= (int64_t)start && dir_offset(e) < (int64_t)end) {
       CACHE_DEC_DIR_USED(vol->mutex);
       dir_set_offset(e, 0); // delete
+      vol->mark_segment_dirty(i / (vol->buckets * DIR_DEPTH));
     }
   }
   dir_clean_vol(vol);
@@ -441,6 +449,7 @@ freelist_clean(int s, Vol *vol)
       }
     }
   }
+  vol->mark_segment_dirty(s);
   dir_clean_segment(s, vol);
 }
 
@@ -463,6 +472,7 @@ freelist_pop(int s, Vol *d)
   if (h) {
     dir_set_prev(h, 0);
   }
+  d->mark_segment_dirty(s);
   return e;
 }
 
@@ -530,6 +540,7 @@ dir_free_entry(Dir *e, int s, Vol *d)
     dir_set_prev(dir_from_offset(fo, seg), eo);
   }
   d->header->freelist[s] = eo;
+  d->mark_segment_dirty(s);
 }
 
 int
@@ -548,7 +559,7 @@ dir_probe(const CacheKey *key, Vol *d, Dir *result, Dir **last_collision)
 #endif
 Lagain:
   e = dir_bucket(b, seg);
-  if (dir_offset(e)) {
+  if (dir_offset(e) && dir_bucket_may_contain(e, b, DIR_MASK_TAG(key->slice32(2)))) {
     do {
       if (dir_compare_tag(e, key)) {
         ink_assert(dir_offset(e));
@@ -649,6 +660,7 @@ Lfill:
          key->slice32(1), dir_tag(e), dir_offset(e));
   CHECK_DIR(d);
   d->header->dirty = 1;
+  d->mark_segment_dirty(s);
   CACHE_INC_DIR_USED(d->mutex);
   return 1;
 }
@@ -726,6 +738,7 @@ Lfill:
          bi, e, t, dir_tag(e), dir_offset(e));
   CHECK_DIR(d);
   d->header->dirty = 1;
+  d->mark_segment_dirty(s);
   return res;
 }
 
@@ -965,21 +978,33 @@ sync_cache_dir_on_shutdown()
     // check if we have data in the agg buffer
     // dont worry about the cachevc s in the agg queue
     // directories have not been inserted for these writes
-    if (d->agg_buf_pos) {
+    // the writes in flight may not have reached the disk yet, write them again in order
+    if (d->agg_writes || d->agg_buf_pos) {
       Debug("cache_dir_sync", "Dir %s: flushing agg buffer first", d->hash_text.get());
 
-      // set write limit
-      d->header->agg_pos = d->header->write_pos + d->agg_buf_pos;
+      bool ok = true;
+      for (int i = 0; ok && i < d->agg_writes; i++) {
+        AggBuffer *b = d->agg_write(i);
+        size_t n     = b->io.aiocb.aio_nbytes;
 
-      int r = pwrite(d->fd, d->agg_buffer, d->agg_buf_pos, d->header->write_pos);
-      if (r != d->agg_buf_pos) {
+        ok                        = pwrite(d->fd, b->buffer, n, b->io.aiocb.aio_offset) == (ssize_t)n;
+        d->header->last_write_pos = b->io.aiocb.aio_offset;
+      }
+      if (ok && d->agg_buf_pos) {
+        ok                        = pwrite(d->fd, d->agg_buffer, d->agg_buf_pos, d->header->agg_pos) == d->agg_buf_pos;
+        d->header->last_write_pos = d->header->agg_pos;
+        d->header->agg_pos += d->agg_buf_pos;
+      }
+      if (!ok) {
         ink_assert(!"flusing agg buffer failed");
         continue;
       }
-      d->header->last_write_pos = d->header->write_pos;
-      d->header->write_pos += d->agg_buf_pos;
-      ink_assert(d->header->write_pos == d->header->agg_pos);
-      d->agg_buf_pos = 0;
+      // the writes in flight are done with as far as the directory is concerned
+      d->agg_buf_head      = (d->agg_buf_head + d->agg_writes) % d->agg_buf_count;
+      d->agg_writes        = 0;
+      d->agg_buffer        = d->agg_write(0)->buffer;
+      d->agg_buf_pos       = 0;
+      d->header->write_pos = d->header->agg_pos;
       d->header->write_serial++;
     }
 
@@ -1029,6 +1054,27 @@ sync_cache_dir_on_shutdown()
   }
 }
 
+// Whether the store block at @a pos of the directory copy being synced has to be written.
+bool
+CacheSync::dirty_block(Vol *vol, off_t pos)
+{
+  off_t seg_start = vol->headerlen();
+  off_t seg_len   = vol->buckets * DIR_DEPTH * SIZEOF_DIR;
+
+  // the freelist heads are kept with the header
+  if (pos < seg_start) {
+    return true;
+  }
+  int first = std::min<off_t>((pos - seg_start) / seg_len, vol->segments - 1);
+  int last  = std::min<off_t>((pos + STORE_BLOCK_SIZE - 1 - seg_start) / seg_len, vol->segments - 1);
+  for (int s = first; s <= last; s++) {
+    if (sync_segments[s]) {
+      return true;
+    }
+  }
+  return false;
+}
+
 int
 CacheSync::mainEvent(int event, Event *e)
 {
@@ -1065,6 +1111,8 @@ Lrestart:
     // AIO Thread
     if (io.aio_result != (int64_t)io.aiocb.aio_nbytes) {
       Warning("vol write error during directory sync '%s'", gvol[vol_idx]->hash_text.get());
+      // the copy being written can no longer be trusted, rewrite all of it next time
+      vol->mark_all_segments_dirty();
       event = EVENT_NONE;
       goto Ldone;
     }
@@ -1106,7 +1154,7 @@ Lrestart:
         Debug("cache_dir_sync", "Dir %s not dirty", vol->hash_text.get());
         goto Ldone;
       }
-      if (vol->is_io_in_progress() || vol->agg_buf_pos) {
+      if (vol->is_io_in_progress() || vol->agg_writes || vol->agg_buf_pos) {
         Debug("cache_dir_sync", "Dir %s: waiting for agg buffer", vol->hash_text.get());
         vol->dir_sync_waiting = true;
         if (!vol->is_io_in_progress()) {
@@ -1138,21 +1186,51 @@ Lrestart:
       vol->header->sync_serial++;
       vol->footer->sync_serial = vol->header->sync_serial;
       CHECK_DIR(d);
-      memcpy(buf, vol->raw_dir, dirlen);
+
+      /* Each copy of the directory on disk only needs the segments that changed since that copy was
+         last written. The header goes out first and the footer last, so a torn copy fails the
+         sync_serial check on recovery and the other copy is used instead.
+       */
+      int copy_dirty  = DIR_COPY_DIRTY(vol->header->sync_serial & 1);
+      off_t seg_start = vol->headerlen();
+      off_t seg_len   = vol->buckets * DIR_DEPTH * SIZEOF_DIR;
+      int64_t written = 0;
+      sync_segments.assign(vol->segments, false);
+      memcpy(buf, vol->raw_dir, seg_start);
+      for (int s = 0; s < vol->segments; s++) {
+        if (!cache_config_dir_sync_incremental || (vol->segment_dirty[s] & copy_dirty)) {
+          off_t first = ROUND_DOWN_TO_STORE_BLOCK(seg_start + s * seg_len);
+          off_t last  = ROUND_TO_STORE_BLOCK(seg_start + (s + 1) * seg_len);
+          memcpy(buf + first, vol->raw_dir + first, last - first);
+          sync_segments[s] = true;
+          ++written;
+        }
+        vol->segment_dirty[s] &= ~copy_dirty;
+      }
+      memcpy(buf + dirlen - headerlen, vol->raw_dir + dirlen - headerlen, headerlen);
+      CACHE_SUM_DYN_STAT(cache_directory_sync_segments_written_stat, written);
+      CACHE_SUM_DYN_STAT(cache_directory_sync_segments_skipped_stat, vol->segments - written);
       vol->dir_sync_in_progress = true;
     }
     size_t B    = vol->header->sync_serial & 1;
     off_t start = vol->skip + (B ? dirlen : 0);
 
+    if (writepos && writepos < (off_t)dirlen - headerlen) {
+      // skip over the segments this copy already has
+      while (writepos < (off_t)dirlen - headerlen && !dirty_block(vol, writepos)) {
+        writepos += STORE_BLOCK_SIZE;
+      }
+    }
+
     if (!writepos) {
       // write header
       aio_write(vol->fd, buf + writepos, headerlen, start + writepos);
       writepos += headerlen;
     } else if (writepos < (off_t)dirlen - headerlen) {
-      // write part of body
-      int l = SYNC_MAX_WRITE;
-      if (writepos + l > (off_t)dirlen - headerlen) {
-        l = dirlen - headerlen - writepos;
+      // write a run of changed segments
+      int l = STORE_BLOCK_SIZE;
+      while (l < SYNC_MAX_WRITE && writepos + l < (off_t)dirlen - headerlen && dirty_block(vol, writepos + l)) {
+        l += STORE_BLOCK_SIZE;
       }
       aio_write(vol->fd, buf + writepos, l, start + writepos);
       writepos += l;
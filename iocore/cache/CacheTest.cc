@@ -587,6 +587,20 @@ test_RamCache(RegressionTest *t, RamCache *cache, const char *name, int64_t cach
     }
   }
 
+  // The often hit objects are the ones to save for a restart.
+  vector<RamCacheKey> hot;
+  cache->hot_keys(hot);
+  if (hot.size() < 10) {
+    pass = false;
+  } else {
+    for (int i = 0; i < 10; i++) {
+      if ((hot[i].key.u64[0] >> 32) >= 10) {
+        pass = false;
+      }
+    }
+  }
+  rprintf(t, "RamCache %s Hot Keys %zu\n", name, hot.size());
+
   int sample_size = cache_size >> 6;
   build_zipf();
   srand48(13);
@@ -644,6 +658,31 @@ test_RamCache(RegressionTest *t, RamCache *cache, const char *name, int64_t cach
     return false;
   }
 
+  // Replay the trace with a request for a new object after each one, as a crawler or a scan of
+  // the content would add. Only hits on the trace objects are counted.
+  data.clear();
+  misses = 0;
+  for (int i = 0; i < sample_size; i++) {
+    for (int s = 0; s < 2; s++) {
+      int64_t k = s ? ZIPF_SIZE + i : r[i];
+      CryptoHash hash;
+      hash.u64[0] = ((uint64_t)k << 32) + k;
+      hash.u64[1] = ((uint64_t)k << 32) + k;
+      Ptr<IOBufferData> get_data;
+      if (!cache->get(&hash, &get_data)) {
+        IOBufferData *d = THREAD_ALLOC(ioDataAllocator, this_thread());
+        d->alloc(BUFFER_SIZE_INDEX_16K);
+        data.push_back(make_ptr(d));
+        cache->put(&hash, data.back().get(), 1 << 15);
+        if (!s && i >= sample_size / 2) {
+          misses++; // Sample last half of the gets.
+        }
+      }
+    }
+  }
+  double scan_hit_rate = 1.0 - (((double)(misses)) / (sample_size / 2));
+  rprintf(t, "RamCache %s Scan Hit Rate %f\n", name, scan_hit_rate);
+
   ats_free(r);
 
   rprintf(t, "RamCache %s Test Done\r", name);
@@ -667,8 +706,91 @@ REGRESSION_TEST(ram_cache)(RegressionTest *t, int level, int *pstatus)
   for (int s = 20; s <= 28; s += 4) {
     int64_t cache_size = 1LL << s;
     *pstatus           = REGRESSION_TEST_PASSED;
-    if (!test_RamCache(t, new_RamCacheLRU(), "LRU", cache_size) || !test_RamCache(t, new_RamCacheCLFUS(), "CLFUS", cache_size)) {
+    if (!test_RamCache(t, new_RamCacheLRU(), "LRU", cache_size) || !test_RamCache(t, new_RamCacheCLFUS(), "CLFUS", cache_size) ||
+        !test_RamCache(t, new_RamCacheTinyLFU(), "TinyLFU", cache_size)) {
       *pstatus = REGRESSION_TEST_FAILED;
     }
   }
 }
+
+// Times dir_probe on a 75% full directory, for keys that are there and keys that are not. This
+// clears volume 0. Run with -R 3 -r cache_dir_probe.
+EXCLUSIVE_REGRESSION_TEST(cache_dir_probe)(RegressionTest *t, int level, int *pstatus)
+{
+  if (REGRESSION_TEST_EXTENDED > level) {
+    *pstatus = REGRESSION_TEST_PASSED;
+    return;
+  }
+
+  if (cacheProcessor.IsCacheEnabled() != CACHE_INITIALIZED || gnvol < 1) {
+    rprintf(t, "cache not initialized");
+    *pstatus = REGRESSION_TEST_FAILED;
+    return;
+  }
+
+  Vol *d          = gvol[0];
+  EThread *thread = this_ethread();
+  MUTEX_TRY_LOCK(lock, d->mutex, thread);
+  ink_release_assert(lock.is_locked());
+  vol_dir_clear(d);
+
+  Dir dir;
+  dir_clear(&dir);
+  dir_set_phase(&dir, 0);
+  dir_set_head(&dir, true);
+  dir_set_offset(&dir, 1);
+  d->header->agg_pos = d->header->write_pos += 1024;
+
+  int n = d->direntries() * 3 / 4;
+  std::vector<CacheKey> keys(n);
+  for (auto &key : keys) {
+    rand_CacheKey(&key, thread->mutex);
+    dir_insert(&key, d, &dir);
+  }
+
+  *pstatus = REGRESSION_TEST_PASSED;
+
+  int found        = 0;
+  ink_hrtime start = Thread::get_hrtime_updated();
+  for (auto &key : keys) {
+    Dir *last_collision = nullptr;
+    found += dir_probe(&key, d, &dir, &last_collision);
+  }
+  ink_hrtime hit_time = Thread::get_hrtime_updated() - start;
+
+  for (auto &key : keys) {
+    rand_CacheKey(&key, thread->mutex);
+  }
+  int false_hits = 0;
+  start          = Thread::get_hrtime_updated();
+  for (auto &key : keys) {
+    Dir *last_collision = nullptr;
+    false_hits += dir_probe(&key, d, &dir, &last_collision);
+  }
+  ink_hrtime miss_time = Thread::get_hrtime_updated() - start;
+
+  // A bucket the quick check rules out must not have the tag anywhere in its chain.
+  int skipped = 0;
+  for (auto &key : keys) {
+    Dir *seg = d->dir_segment(key.slice32(0) % d->segments);
+    int b    = key.slice32(1) % d->buckets;
+    Dir *e   = dir_bucket(b, seg);
+    if (dir_bucket_may_contain(e, b, DIR_MASK_TAG(key.slice32(2)))) {
+      continue;
+    }
+    ++skipped;
+    for (; e && !dir_is_empty(e); e = next_dir(e, seg)) {
+      if (dir_compare_tag(e, &key)) {
+        rprintf(t, "bucket %d of segment %d was skipped but holds the tag\n", b, key.slice32(0) % d->segments);
+        *pstatus = REGRESSION_TEST_FAILED;
+        break;
+      }
+    }
+  }
+
+  rprintf(t, "%d entries: %d hits at %" PRId64 " ns/probe, %d false hits at %" PRId64 " ns/probe\n", n, found, hit_time / n,
+          false_hits, miss_time / n);
+  rprintf(t, "%d%% of the misses did not walk the bucket\n", (int)(skipped * INT64_C(100) / n));
+
+  vol_dir_clear(d);
+}
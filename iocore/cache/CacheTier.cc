@@ -0,0 +1,203 @@
+/** @file
+
+  A fast (SSD) tier in front of the cache volumes.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "P_Cache.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#define TIER_ALIGN 4096                   // copies are aligned for O_DIRECT
+#define TIER_AVERAGE_FRAGMENT (64 * 1024) // used to size the sketch
+#define TIER_MAX_FRAGMENT_FRACTION 16     // fragments larger than this part of the tier are not copied
+
+CacheTier *cache_tier = nullptr;
+
+struct CacheTierWrite : public Continuation {
+  CacheTierEntry *entry;
+  Ptr<IOBufferData> data;
+  AIOCallbackInternal io;
+
+  int
+  handleWriteDone(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+  {
+    cache_tier->write_done(this);
+    delete this;
+    return EVENT_DONE;
+  }
+
+  CacheTierWrite(CacheTierEntry *e) : Continuation(cache_tier->mutex), entry(e) { SET_HANDLER(&CacheTierWrite::handleWriteDone); }
+};
+
+CacheTier::CacheTier(const char *apath, int afd, int64_t asize)
+  : mutex(new_ProxyMutex()), path(ats_strdup(apath)), fd(afd), size(asize)
+{
+  sketch.init(size / TIER_AVERAGE_FRAGMENT);
+}
+
+bool
+CacheTier::lookup(Vol *vol, const CryptoHash *key, const Dir *dir, int64_t &tier_offset, uint32_t &len)
+{
+  MUTEX_TRY_LOCK(lock, mutex, this_ethread());
+  if (!lock.is_locked()) {
+    return false;
+  }
+  auto spot = index.find(CacheTierKey{vol, *key, dir_offset(dir), dir_phase(dir)});
+  if (spot == index.end() || spot->second->write) {
+    return false;
+  }
+  tier_offset = spot->second->offset;
+  len         = spot->second->len;
+  return true;
+}
+
+void
+CacheTier::demote(CacheTierEntry *e)
+{
+  if (e->write) {
+    e->write->entry = nullptr;
+  }
+  index.erase(e->key);
+  log.remove(e);
+  bytes_used -= e->len;
+  delete e;
+}
+
+void
+CacheTier::promote(Vol *vol, const CryptoHash *key, const Dir *dir, Doc *doc)
+{
+  MUTEX_TRY_LOCK(lock, mutex, this_ethread());
+  if (!lock.is_locked()) {
+    return;
+  }
+  CacheTierKey k{vol, *key, dir_offset(dir), dir_phase(dir)};
+  uint32_t len = INK_ALIGN(doc->len, TIER_ALIGN);
+
+  sketch.increment(key);
+  if (sketch.frequency(key) < cache_config_tier_promote_hits || len > size / TIER_MAX_FRAGMENT_FRACTION ||
+      index.find(k) != index.end()) {
+    return;
+  }
+
+  // The log is in tier order starting from write_pos, so the fragments to overwrite are at its head.
+  // The end of the tier is left unused if the fragment does not fit before it.
+  int64_t pos = write_pos + len > size ? 0 : write_pos;
+  int victims = 0, victim_hits = 0;
+  for (CacheTierEntry *e = log.head; e; e = log.next(e), ++victims) {
+    bool overwritten =
+      pos < write_pos ? e->offset >= write_pos || e->offset < pos + len : e->offset >= pos && e->offset < pos + len;
+    if (!overwritten) {
+      break;
+    }
+    // AIO may complete writes out of order, a copy still being written could land over ours.
+    if (e->write) {
+      CACHE_INCREMENT_DYN_STAT(cache_tier_promote_failure_stat);
+      return;
+    }
+    victim_hits += sketch.frequency(&e->key.key);
+  }
+  if (victims && sketch.frequency(key) <= victim_hits) {
+    CACHE_INCREMENT_DYN_STAT(cache_tier_promote_failure_stat);
+    return;
+  }
+  while (victims--) {
+    CACHE_INCREMENT_DYN_STAT(cache_tier_demote_stat);
+    demote(log.head);
+  }
+
+  CacheTierEntry *e = new CacheTierEntry;
+  e->key            = k;
+  e->offset         = pos;
+  e->len            = len;
+  e->write          = new CacheTierWrite(e);
+  index[k]          = e;
+  log.enqueue(e);
+  write_pos = pos + len;
+  bytes_used += len;
+  CACHE_INCREMENT_DYN_STAT(cache_tier_promote_success_stat);
+  GLOBAL_CACHE_SET_DYN_STAT(cache_tier_bytes_used_stat, bytes_used);
+
+  CacheTierWrite *w = e->write;
+  w->data           = new_IOBufferData(iobuffer_size_to_index(len, MAX_BUFFER_SIZE_INDEX), MEMALIGNED);
+  memcpy(w->data->data(), doc, doc->len);
+  memset(w->data->data() + doc->len, 0, len - doc->len);
+  w->io.aiocb.aio_fildes = fd;
+  w->io.aiocb.aio_offset = pos;
+  w->io.aiocb.aio_buf    = w->data->data();
+  w->io.aiocb.aio_nbytes = len;
+  w->io.action           = w;
+  w->io.thread           = AIO_CALLBACK_THREAD_ANY;
+  ink_assert(ink_aio_write(&w->io) >= 0);
+}
+
+void
+CacheTier::write_done(CacheTierWrite *w)
+{
+  CacheTierEntry *e = w->entry;
+
+  if (!e) { // demoted while it was written
+    return;
+  }
+  e->write = nullptr;
+  if (!w->io.ok()) {
+    Warning("cache tier '%s': write of %u bytes at %" PRId64 " failed", path.get(), e->len, e->offset);
+    demote(e);
+    GLOBAL_CACHE_SET_DYN_STAT(cache_tier_bytes_used_stat, bytes_used);
+  }
+}
+
+void
+cache_tier_init()
+{
+  ats_scoped_str path;
+  int64_t size = 0;
+
+  REC_ReadConfigStringAlloc(path, "proxy.config.cache.tier.path");
+  REC_ReadConfigInteger(size, "proxy.config.cache.tier.size");
+  if (!path || !*path || size <= 0) {
+    return;
+  }
+  size &= ~(int64_t)(TIER_ALIGN - 1);
+
+  int opts = O_RDWR | O_CREAT;
+#ifdef O_DIRECT
+  opts |= O_DIRECT;
+#endif
+  int fd = open(path, opts, 0644);
+  if (fd < 0) { // a file on a filesystem without O_DIRECT, e.g. tmpfs
+    fd = open(path, O_RDWR | O_CREAT, 0644);
+  }
+  if (fd < 0) {
+    Warning("cache tier '%s' disabled: %s", path.get(), strerror(errno));
+    return;
+  }
+  struct stat sbuf;
+  if (fstat(fd, &sbuf) == 0 && S_ISREG(sbuf.st_mode) && sbuf.st_size < size && ftruncate(fd, size) < 0) {
+    Warning("cache tier '%s' disabled: unable to extend it to %" PRId64 " bytes", path.get(), size);
+    close(fd);
+    return;
+  }
+
+  cache_tier = new CacheTier(path, fd, size);
+  GLOBAL_CACHE_SET_DYN_STAT(cache_tier_bytes_total_stat, size);
+  Note("cache tier '%s' enabled, %" PRId64 " bytes", path.get(), size);
+}
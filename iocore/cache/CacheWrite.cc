@@ -181,6 +181,43 @@ CacheVC::updateVector(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
    The functions sets the length, offset, pinned, head and phase of vc->dir.
    */
 
+// Whether a new object may be written to its stripe, see proxy.config.cache.admission.enabled.
+// Each attempt to write the object is counted, the more often it has been tried the more likely
+// it is to be read again. Large objects need more attempts, one more each time the size doubles
+// past proxy.config.cache.admission.large_object_size, and nothing more is admitted once the
+// stripe has written proxy.config.cache.admission.write_budget bytes in the current second.
+static bool
+admit_write(CacheVC *vc)
+{
+  ProxyMutex *mutex = vc->mutex.get();
+  Vol *vol          = vc->vol;
+  int64_t size      = vc->vio.nbytes != INT64_MAX ? vc->vio.nbytes : vc->vio.ndone;
+  ink_hrtime now    = Thread::get_hrtime();
+
+  if (now - vol->admission_window >= HRTIME_SECOND) {
+    vol->admission_window       = now;
+    vol->admission_window_bytes = 0;
+  }
+  vol->admission_sketch.increment(&vc->first_key);
+
+  int hits = cache_config_admission_min_hits;
+  if (cache_config_admission_large_size > 0) {
+    for (int64_t s = cache_config_admission_large_size; s < size && hits < 15; s <<= 1) {
+      ++hits;
+    }
+  }
+  bool admit = vol->admission_sketch.frequency(&vc->first_key) >= hits &&
+               !(cache_config_admission_write_budget > 0 && vol->admission_window_bytes >= cache_config_admission_write_budget);
+  if (admit) {
+    CACHE_INCREMENT_DYN_STAT(cache_admission_admitted_stat);
+    CACHE_SUM_DYN_STAT(cache_admission_admitted_bytes_stat, size);
+  } else {
+    CACHE_INCREMENT_DYN_STAT(cache_admission_rejected_stat);
+    CACHE_SUM_DYN_STAT(cache_admission_rejected_bytes_stat, size);
+  }
+  return admit;
+}
+
 int
 CacheVC::handleWrite(int event, Event * /* e ATS_UNUSED */)
 {
@@ -210,7 +247,22 @@ CacheVC::handleWrite(int event, Event * /* e ATS_UNUSED */)
     }
     return handleEvent(AIO_EVENT_DONE, nullptr);
   }
+  if (vol->admission_sketch.table) {
+    // only the first write of a new object is checked, later fragments follow that decision
+    if (cache_config_admission_enabled && frag_type == CACHE_FRAG_TYPE_HTTP && !f.update && !f.evacuator && !fragment &&
+        !admit_write(this)) {
+      CACHE_INCREMENT_DYN_STAT(base_stat + CACHE_STAT_FAILURE);
+      vol->agg_todo_size -= agg_len;
+      io.aio_result = AIO_SOFT_FAILURE;
+      if (event == EVENT_CALL) {
+        return EVENT_RETURN;
+      }
+      return handleEvent(AIO_EVENT_DONE, nullptr);
+    }
+    vol->admission_window_bytes += agg_len;
+  }
   ink_assert(agg_len <= AGG_SIZE);
+  agg_time = Thread::get_hrtime();
   if (f.evac_vector) {
     vol->agg.push(this);
   } else {
@@ -278,10 +330,10 @@ void
 Vol::scan_for_pinned_documents()
 {
   if (cache_config_permit_pinning) {
-    // we can't evacuate anything between header->write_pos and
-    // header->write_pos + AGG_SIZE.
-    int ps                = this->offset_to_vol_offset(header->write_pos + AGG_SIZE);
-    int pe                = this->offset_to_vol_offset(header->write_pos + 2 * EVACUATION_SIZE + (len / PIN_SCAN_EVERY));
+    // we can't evacuate anything between header->agg_pos and
+    // header->agg_pos + AGG_SIZE.
+    int ps                = this->offset_to_vol_offset(header->agg_pos + AGG_SIZE);
+    int pe                = this->offset_to_vol_offset(header->agg_pos + 2 * EVACUATION_SIZE + (len / PIN_SCAN_EVERY));
     int vol_end_offset    = this->offset_to_vol_offset(len + skip);
     int before_end_of_vol = pe < vol_end_offset;
     DDebug("cache_evac", "scan %d %d", ps, pe);
@@ -307,13 +359,19 @@ Vol::scan_for_pinned_documents()
   }
 }
 
+int
+AggBuffer::handle_write_done(int event, void * /* data ATS_UNUSED */)
+{
+  return vol->aggWriteDone(event, this);
+}
+
 /* NOTE:: This state can be called by an AIO thread, so DON'T DON'T
    DON'T schedule any events on this thread using VC_SCHED_XXX or
    mutex->thread_holding->schedule_xxx_local(). ALWAYS use
    eventProcessor.schedule_xxx().
    */
 int
-Vol::aggWriteDone(int event, Event *e)
+Vol::aggWriteDone(int event, AggBuffer *b)
 {
   cancel_trigger();
 
@@ -321,40 +379,54 @@ Vol::aggWriteDone(int event, Event *e)
   // retaking the current mutex recursively is a NOOP
   CACHE_TRY_LOCK(lock, dir_sync_waiting ? cacheDirSync->mutex : mutex, mutex->thread_holding);
   if (!lock.is_locked()) {
-    eventProcessor.schedule_in(this, HRTIME_MSECONDS(cache_config_mutex_retry_delay));
+    eventProcessor.schedule_in(b, HRTIME_MSECONDS(cache_config_mutex_retry_delay));
     return EVENT_CONT;
   }
-  if (io.ok()) {
-    header->last_write_pos = header->write_pos;
-    header->write_pos += io.aiocb.aio_nbytes;
-    ink_assert(header->write_pos >= start);
-    DDebug("cache_agg", "Dir %s, Write: %" PRIu64 ", last Write: %" PRIu64 "", hash_text.get(), header->write_pos,
-           header->last_write_pos);
-    ink_assert(header->write_pos == header->agg_pos);
-    if (header->write_pos + EVACUATION_SIZE > scan_pos) {
-      periodic_scan();
-    }
-    agg_buf_pos = 0;
-    header->write_serial++;
-  } else {
-    // delete all the directory entries that we inserted
-    // for fragments is this aggregation buffer
-    Debug("cache_disk_error", "Write error on disk %s\n \
+  b->done = true;
+  // retire the writes in the order they were issued, write_pos must not pass a write still in flight
+  while (agg_writes && agg_write(0)->done) {
+    AggBuffer *w = agg_write(0);
+    if (w->io.ok()) {
+      header->last_write_pos = header->write_pos;
+      header->write_pos += w->io.aiocb.aio_nbytes;
+      ink_assert(header->write_pos >= start);
+      DDebug("cache_agg", "Dir %s, Write: %" PRIu64 ", last Write: %" PRIu64 "", hash_text.get(), header->write_pos,
+             header->last_write_pos);
+      ink_assert(header->write_pos <= header->agg_pos);
+      if (header->write_pos + EVACUATION_SIZE > scan_pos) {
+        periodic_scan();
+      }
+      header->write_serial++;
+    } else {
+      // delete all the directory entries that we inserted
+      // for fragments is this aggregation buffer
+      Debug("cache_disk_error", "Write error on disk %s\n \
               write range : [%" PRIu64 " - %" PRIu64 " bytes]  [%" PRIu64 " - %" PRIu64 " blocks] \n",
-          hash_text.get(), (uint64_t)io.aiocb.aio_offset, (uint64_t)io.aiocb.aio_offset + io.aiocb.aio_nbytes,
-          (uint64_t)io.aiocb.aio_offset / CACHE_BLOCK_SIZE,
-          (uint64_t)(io.aiocb.aio_offset + io.aiocb.aio_nbytes) / CACHE_BLOCK_SIZE);
-    Dir del_dir;
-    dir_clear(&del_dir);
-    for (int done = 0; done < agg_buf_pos;) {
-      Doc *doc = (Doc *)(agg_buffer + done);
-      dir_set_offset(&del_dir, header->write_pos + done);
-      dir_delete(&doc->key, this, &del_dir);
-      done += round_to_approx_size(doc->len);
+            hash_text.get(), (uint64_t)w->io.aiocb.aio_offset, (uint64_t)w->io.aiocb.aio_offset + w->io.aiocb.aio_nbytes,
+            (uint64_t)w->io.aiocb.aio_offset / CACHE_BLOCK_SIZE,
+            (uint64_t)(w->io.aiocb.aio_offset + w->io.aiocb.aio_nbytes) / CACHE_BLOCK_SIZE);
+      Dir del_dir;
+      dir_clear(&del_dir);
+      for (int done = 0; done < (int)w->io.aiocb.aio_nbytes;) {
+        Doc *doc = (Doc *)(w->buffer + done);
+        dir_set_offset(&del_dir, header->write_pos + done);
+        dir_delete(&doc->key, this, &del_dir);
+        done += round_to_approx_size(doc->len);
+      }
+      if (agg_writes == 1 && !agg_buf_pos) {
+        // nothing was placed after this write, try the same space again
+        header->agg_pos = header->write_pos;
+      } else {
+        // later fragments were already placed after this write, skip over it
+        header->write_pos += w->io.aiocb.aio_nbytes;
+      }
     }
-    agg_buf_pos = 0;
+    agg_buf_head = (agg_buf_head + 1) % agg_buf_count;
+    agg_writes--;
+  }
+  if (!agg_buffer && agg_writes < agg_buf_count) {
+    agg_buffer = agg_write(agg_writes)->buffer;
   }
-  set_io_not_in_progress();
   // callback ready sync CacheVCs
   CacheVC *c = nullptr;
   while ((c = sync.dequeue())) {
@@ -365,12 +437,12 @@ Vol::aggWriteDone(int event, Event *e)
       break;
     }
   }
-  if (dir_sync_waiting) {
+  if (dir_sync_waiting && !agg_writes) {
     dir_sync_waiting = false;
     cacheDirSync->handleEvent(EVENT_IMMEDIATE, nullptr);
   }
-  if (agg.head || sync.head) {
-    return aggWrite(event, e);
+  if ((agg.head || sync.head) && !is_io_in_progress()) {
+    return aggWrite(event, nullptr);
   }
   return EVENT_CONT;
 }
@@ -598,6 +670,7 @@ Vol::evacuateWrite(CacheVC *evacuator, int event, Event *e)
     after = cur;
   }
   ink_assert(evacuator->agg_len <= AGG_SIZE);
+  evacuator->agg_time = Thread::get_hrtime();
   agg.insert(evacuator, after);
   return aggWrite(event, e);
 }
@@ -741,7 +814,7 @@ static int
 agg_copy(char *p, CacheVC *vc)
 {
   Vol *vol = vc->vol;
-  off_t o  = vol->header->write_pos + vol->agg_buf_pos;
+  off_t o  = vol->header->agg_pos + vol->agg_buf_pos;
 
   if (!vc->f.evacuator) {
     Doc *doc                   = (Doc *)p;
@@ -846,10 +919,7 @@ agg_copy(char *p, CacheVC *vc)
 #endif
     }
     if (cache_config_enable_checksum) {
-      doc->checksum = 0;
-      for (char *b = doc->hdr(); b < (char *)doc + doc->len; b++) {
-        doc->checksum += *b;
-      }
+      doc->checksum = doc->compute_checksum();
     }
     if (vc->frag_type == CACHE_FRAG_TYPE_HTTP && vc->f.single_fragment) {
       ink_assert(doc->hlen);
@@ -975,23 +1045,44 @@ Vol::aggWrite(int event, void * /* e ATS_UNUSED */)
 
   Que(CacheVC, link) tocall;
   CacheVC *c;
+  ink_hrtime now = Thread::get_hrtime_updated();
 
   cancel_trigger();
 
 Lagain:
+  // every buffer is in flight, or a directory sync is waiting for the writes in flight to finish
+  if (!agg_buffer || (dir_sync_waiting && agg_writes)) {
+    goto Lwait;
+  }
   // calculate length of aggregated write
   for (c = (CacheVC *)agg.head; c;) {
     int writelen = c->agg_len;
     // [amc] this is checked multiple places, on here was it strictly less.
     ink_assert(writelen <= AGG_SIZE);
-    if (agg_buf_pos + writelen > AGG_SIZE || header->write_pos + agg_buf_pos + writelen > (skip + len)) {
+    if (agg_buf_pos + writelen > AGG_SIZE || header->agg_pos + agg_buf_pos + writelen > (skip + len)) {
       break;
     }
-    DDebug("agg_read", "copying: %d, %" PRIu64 ", key: %d", agg_buf_pos, header->write_pos + agg_buf_pos, c->first_key.slice32(0));
+    DDebug("agg_read", "copying: %d, %" PRIu64 ", key: %d", agg_buf_pos, header->agg_pos + agg_buf_pos, c->first_key.slice32(0));
     int wrotelen = agg_copy(agg_buffer + agg_buf_pos, c);
     ink_assert(writelen == wrotelen);
     agg_todo_size -= writelen;
     agg_buf_pos += writelen;
+    {
+      Vol *vol        = this; // must be named "vol" to make STAT macros work.
+      ink_hrtime wait = now - c->agg_time;
+      CACHE_SUM_DYN_STAT(cache_agg_wait_time_stat, wait);
+      if (wait <= HRTIME_MSECONDS(1)) {
+        CACHE_INCREMENT_DYN_STAT(cache_agg_wait_1ms_stat);
+      } else if (wait <= HRTIME_MSECONDS(10)) {
+        CACHE_INCREMENT_DYN_STAT(cache_agg_wait_10ms_stat);
+      } else if (wait <= HRTIME_MSECONDS(100)) {
+        CACHE_INCREMENT_DYN_STAT(cache_agg_wait_100ms_stat);
+      } else if (wait <= HRTIME_SECONDS(1)) {
+        CACHE_INCREMENT_DYN_STAT(cache_agg_wait_1s_stat);
+      } else {
+        CACHE_INCREMENT_DYN_STAT(cache_agg_wait_inf_stat);
+      }
+    }
     CacheVC *n = (CacheVC *)c->link.next;
     agg.dequeue();
     if (c->f.sync && c->f.use_first_key) {
@@ -1011,9 +1102,9 @@ Lagain:
   // if we got nothing...
   if (!agg_buf_pos) {
     if (!agg.head && !sync.head) { // nothing to get
-      return EVENT_CONT;
+      goto Lwait;
     }
-    if (header->write_pos == start) {
+    if (header->agg_pos == start) {
       // write aggregation too long, bad bad, punt on everything.
       Note("write aggregation exceeds vol size");
       ink_assert(!tocall.head);
@@ -1028,22 +1119,27 @@ Lagain:
       }
       return EVENT_CONT;
     }
-    // start back
+    // start back, once the writes at the end of the volume are done
     if (agg.head) {
+      if (agg_writes) {
+        goto Lwait;
+      }
       agg_wrap();
       goto Lagain;
     }
   }
 
-  // evacuate space
-  off_t end = header->write_pos + agg_buf_pos + EVACUATION_SIZE;
-  if (evac_range(header->write_pos, end, !header->phase) < 0) {
-    goto Lwait;
-  }
-  if (end > skip + len) {
-    if (evac_range(start, start + (end - (skip + len)), header->phase) < 0) {
+  {
+    // evacuate space
+    off_t end = header->agg_pos + agg_buf_pos + EVACUATION_SIZE;
+    if (evac_range(header->agg_pos, end, !header->phase) < 0) {
       goto Lwait;
     }
+    if (end > skip + len) {
+      if (evac_range(start, start + (end - (skip + len)), header->phase) < 0) {
+        goto Lwait;
+      }
+    }
   }
 
   // if agg.head, then we are near the end of the disk, so
@@ -1052,9 +1148,12 @@ Lagain:
     goto Lwait;
   }
 
-  // write sync marker
+  // write sync marker, unless the writes in flight are going to move write_serial on anyway
   if (!agg_buf_pos) {
     ink_assert(sync.head);
+    if (agg_writes) {
+      goto Lwait;
+    }
     int l       = round_to_approx_size(sizeof(Doc));
     agg_buf_pos = l;
     Doc *d      = (Doc *)agg_buffer;
@@ -1065,22 +1164,32 @@ Lagain:
     d->write_serial = header->write_serial;
   }
 
-  // set write limit
-  header->agg_pos = header->write_pos + agg_buf_pos;
+  {
+    AggBuffer *b           = agg_write(agg_writes);
+    b->done                = false;
+    b->io.aiocb.aio_fildes = fd;
+    b->io.aiocb.aio_offset = header->agg_pos;
+    b->io.aiocb.aio_buf    = agg_buffer;
+    b->io.aiocb.aio_nbytes = agg_buf_pos;
+    b->io.action           = b;
+    /*
+      Callback on AIO thread so that we can issue a new write ASAP
+      as all writes are serialized in the volume.  This is not necessary
+      for reads proceed independently.
+     */
+    b->io.thread = AIO_CALLBACK_THREAD_AIO;
 
-  io.aiocb.aio_fildes = fd;
-  io.aiocb.aio_offset = header->write_pos;
-  io.aiocb.aio_buf    = agg_buffer;
-  io.aiocb.aio_nbytes = agg_buf_pos;
-  io.action           = this;
-  /*
-    Callback on AIO thread so that we can issue a new write ASAP
-    as all writes are serialized in the volume.  This is not necessary
-    for reads proceed independently.
-   */
-  io.thread = AIO_CALLBACK_THREAD_AIO;
-  SET_HANDLER(&Vol::aggWriteDone);
-  ink_aio_write(&io);
+    // set write limit
+    header->agg_pos += agg_buf_pos;
+    agg_buf_pos = 0;
+    agg_writes++;
+    agg_buffer = agg_writes < agg_buf_count ? agg_write(agg_writes)->buffer : nullptr;
+    ink_aio_write(&b->io);
+  }
+  // keep aggregating into the next buffer while this one is written
+  if (agg.head) {
+    goto Lagain;
+  }
 
 Lwait:
   int ret = EVENT_CONT;
@@ -1646,14 +1755,19 @@ Cache::open_write(Continuation *cont, const CacheKey *key, CacheFragType frag_ty
 
   ink_assert(caches[frag_type] == this);
 
+  Vol *vol = key_to_vol(key, hostname, host_len);
+  if (!vol) {
+    cont->handleEvent(CACHE_EVENT_OPEN_WRITE_FAILED, (void *)-ECACHE_NOT_READY);
+    return ACTION_RESULT_DONE;
+  }
+
   intptr_t res      = 0;
   CacheVC *c        = new_CacheVC(cont);
   ProxyMutex *mutex = cont->mutex.get();
   SCOPED_MUTEX_LOCK(lock, c->mutex, this_ethread());
   c->vio.op    = VIO::WRITE;
   c->base_stat = cache_write_active_stat;
-  c->vol       = key_to_vol(key, hostname, host_len);
-  Vol *vol     = c->vol;
+  c->vol       = vol;
   CACHE_INCREMENT_DYN_STAT(c->base_stat + CACHE_STAT_ACTIVE);
   c->first_key = c->key = *key;
   c->frag_type          = frag_type;
@@ -1711,6 +1825,12 @@ Cache::open_write(Continuation *cont, const CacheKey *key, CacheHTTPInfo *info,
   }
 
   ink_assert(caches[type] == this);
+  Vol *vol = key_to_vol(key, hostname, host_len);
+  if (!vol) {
+    cont->handleEvent(CACHE_EVENT_OPEN_WRITE_FAILED, (void *)-ECACHE_NOT_READY);
+    return ACTION_RESULT_DONE;
+  }
+
   intptr_t err      = 0;
   int if_writers    = (uintptr_t)info == CACHE_ALLOW_MULTIPLE_WRITES;
   CacheVC *c        = new_CacheVC(cont);
@@ -1729,8 +1849,7 @@ Cache::open_write(Continuation *cont, const CacheKey *key, CacheHTTPInfo *info,
   } while (DIR_MASK_TAG(c->key.slice32(2)) == DIR_MASK_TAG(c->first_key.slice32(2)));
   c->earliest_key = c->key;
   c->frag_type    = CACHE_FRAG_TYPE_HTTP;
-  c->vol          = key_to_vol(key, hostname, host_len);
-  Vol *vol        = c->vol;
+  c->vol          = vol;
   c->info         = info;
   if (c->info && (uintptr_t)info != CACHE_ALLOW_MULTIPLE_WRITES) {
     /*
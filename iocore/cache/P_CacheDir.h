@@ -24,9 +24,12 @@
 #pragma once
 
 #include "P_CacheHttp.h"
+#include <vector>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 struct Vol;
-struct InterimCacheVol;
 struct CacheVC;
 
 /*
@@ -54,6 +57,9 @@ struct CacheVC;
 
 #define SYNC_MAX_WRITE (2 * 1024 * 1024)
 #define SYNC_DELAY HRTIME_MSECONDS(500)
+// Vol::segment_dirty holds one bit per on disk copy (A and B) of the directory
+#define DIR_COPY_DIRTY(_copy) (1 << (_copy))
+#define DIR_COPY_DIRTY_ALL (DIR_COPY_DIRTY(0) | DIR_COPY_DIRTY(1))
 #define DO_NOT_REMOVE_THIS 0
 
 // Debugging Options
@@ -266,8 +272,10 @@ struct CacheSync : public Continuation {
   AIOCallbackInternal io;
   Event *trigger;
   ink_hrtime start_time;
+  std::vector<bool> sync_segments; // segments of the current vol being written in this sync
   int mainEvent(int event, Event *e);
   void aio_write(int fd, char *b, int n, off_t o);
+  bool dirty_block(Vol *vol, off_t pos);
 
   CacheSync()
     : Continuation(new_ProxyMutex()),
@@ -360,3 +368,42 @@ dir_bucket_row(Dir *b, int64_t i)
 {
   return dir_in_seg(b, i);
 }
+
+/*
+  Check whether the chain of bucket @a b (number @a bucket in its segment) can hold an entry with
+  @a tag, without following the chain. The chain starts at the first entry of the bucket, so if no
+  entry of the bucket has the tag and no entry links out of the bucket, it can't. False positives
+  (free entries with a stale tag or link) only cost the usual walk.
+*/
+TS_INLINE bool
+dir_bucket_may_contain(const Dir *b, int64_t bucket, uint32_t tag)
+{
+  uint16_t first = (uint16_t)(bucket * DIR_DEPTH);
+#if defined(__SSE2__) && DIR_DEPTH == 4
+  // Words 2-9 and 12-19 of the bucket, each has the tag and next link of two entries in words 0, 1, 5 and 6.
+  const __m128i tag_mask = _mm_set1_epi16((1 << DIR_TAG_WIDTH) - 1);
+  const __m128i tag_v    = _mm_set1_epi16((int16_t)tag);
+  const __m128i first_v  = _mm_set1_epi16((int16_t)first);
+  const __m128i last_v   = _mm_set1_epi16(DIR_DEPTH - 1);
+  const __m128i zero     = _mm_setzero_si128();
+  int hits               = 0;
+
+  for (int i = 0; i < DIR_DEPTH; i += 2) {
+    __m128i v       = _mm_loadu_si128((const __m128i *)&dir_in_seg(b, i)->w[2]);
+    __m128i tag_eq  = _mm_cmpeq_epi16(_mm_and_si128(v, tag_mask), tag_v);
+    __m128i next_in = _mm_or_si128(_mm_cmpeq_epi16(v, zero),
+                                   _mm_cmpeq_epi16(_mm_subs_epu16(_mm_sub_epi16(v, first_v), last_v), zero));
+    hits |= (_mm_movemask_epi8(tag_eq) & 0x0C03) | (~_mm_movemask_epi8(next_in) & 0x300C);
+  }
+  return hits != 0;
+#else
+  for (int i = 0; i < DIR_DEPTH; i++) {
+    const Dir *e  = dir_in_seg(b, i);
+    uint16_t next = dir_next(e);
+    if (dir_tag(e) == tag || (next && (uint16_t)(next - first) >= DIR_DEPTH)) {
+      return true;
+    }
+  }
+  return false;
+#endif
+}
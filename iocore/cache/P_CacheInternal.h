@@ -105,6 +105,42 @@ enum {
   cache_direntries_used_stat,
   cache_ram_cache_hits_stat,
   cache_ram_cache_misses_stat,
+  cache_ram_cache_fastlz_bytes_in_stat,
+  cache_ram_cache_fastlz_bytes_out_stat,
+  cache_ram_cache_fastlz_compress_time_stat,
+  cache_ram_cache_fastlz_hits_stat,
+  cache_ram_cache_fastlz_decompress_time_stat,
+  cache_ram_cache_libz_bytes_in_stat,
+  cache_ram_cache_libz_bytes_out_stat,
+  cache_ram_cache_libz_compress_time_stat,
+  cache_ram_cache_libz_hits_stat,
+  cache_ram_cache_libz_decompress_time_stat,
+  cache_ram_cache_liblzma_bytes_in_stat,
+  cache_ram_cache_liblzma_bytes_out_stat,
+  cache_ram_cache_liblzma_compress_time_stat,
+  cache_ram_cache_liblzma_hits_stat,
+  cache_ram_cache_liblzma_decompress_time_stat,
+  cache_ram_cache_zstd_bytes_in_stat,
+  cache_ram_cache_zstd_bytes_out_stat,
+  cache_ram_cache_zstd_compress_time_stat,
+  cache_ram_cache_zstd_hits_stat,
+  cache_ram_cache_zstd_decompress_time_stat,
+  cache_ram_cache_warm_active_stat,
+  cache_ram_cache_warm_success_stat,
+  cache_ram_cache_warm_failure_stat,
+  cache_ram_cache_warm_pending_stat,
+  cache_tier_fast_hits_stat,
+  cache_tier_slow_hits_stat,
+  cache_tier_promote_success_stat,
+  cache_tier_promote_failure_stat,
+  cache_tier_demote_stat,
+  cache_tier_read_failure_stat,
+  cache_tier_bytes_used_stat,
+  cache_tier_bytes_total_stat,
+  cache_admission_admitted_stat,
+  cache_admission_admitted_bytes_stat,
+  cache_admission_rejected_stat,
+  cache_admission_rejected_bytes_stat,
   cache_pread_count_stat,
   cache_percent_full_stat,
   cache_lookup_active_stat,
@@ -145,6 +181,18 @@ enum {
   cache_directory_sync_count_stat,
   cache_directory_sync_time_stat,
   cache_directory_sync_bytes_stat,
+  cache_directory_sync_segments_written_stat,
+  cache_directory_sync_segments_skipped_stat,
+  cache_init_dir_read_time_stat,
+  cache_init_recover_time_stat,
+  cache_init_clean_time_stat,
+  cache_agg_wait_1ms_stat,
+  cache_agg_wait_10ms_stat,
+  cache_agg_wait_100ms_stat,
+  cache_agg_wait_1s_stat,
+  cache_agg_wait_inf_stat,
+  cache_agg_wait_time_stat,
+  cache_checksum_failure_stat,
   /* AIO read/write error counters */
   cache_span_errors_read_stat,
   cache_span_errors_write_stat,
@@ -206,12 +254,15 @@ extern RecRawStatBlock *cache_rsb;
 
 // Configuration
 extern int cache_config_dir_sync_frequency;
+extern int cache_config_dir_sync_incremental;
+extern int cache_config_init_serve_partial;
 extern int cache_config_http_max_alts;
 extern int cache_config_permit_pinning;
 extern int cache_config_select_alternate;
 extern int cache_config_max_doc_size;
 extern int cache_config_min_average_object_size;
 extern int cache_config_agg_write_backlog;
+extern int cache_config_agg_write_buffers;
 extern int cache_config_enable_checksum;
 extern int cache_config_alt_rewrite_max_size;
 extern int cache_config_read_while_writer;
@@ -219,6 +270,14 @@ extern int cache_config_agg_write_backlog;
 extern int cache_config_ram_cache_compress;
 extern int cache_config_ram_cache_compress_percent;
 extern int cache_config_ram_cache_use_seen_filter;
+extern int cache_config_ram_cache_zstd_dict_size;
+extern int cache_config_ram_cache_persist_interval;
+extern int cache_config_ram_cache_warm_rate;
+extern int cache_config_tier_promote_hits;
+extern int cache_config_admission_enabled;
+extern int cache_config_admission_min_hits;
+extern int64_t cache_config_admission_large_size;
+extern int64_t cache_config_admission_write_budget;
 extern int cache_config_hit_evacuate_percent;
 extern int cache_config_hit_evacuate_size_limit;
 extern int cache_config_force_sector_size;
@@ -354,6 +413,8 @@ struct CacheVC : public CacheVConnection {
   int scanOpenWrite(int event, Event *e);
   int scanRemoveDone(int event, Event *e);
 
+  int ramCacheWarmRead(int event, Event *e);
+
   int
   is_io_in_progress()
   {
@@ -449,6 +510,7 @@ struct CacheVC : public CacheVConnection {
   int frag_len;          // for communicating with agg_copy
   uint32_t write_len;    // for communicating with agg_copy
   uint32_t agg_len;      // for communicating with aggWrite
+  ink_hrtime agg_time;   // when the fragment was queued for aggWrite
   uint32_t write_serial; // serial of the final write for SYNC
   Vol *vol;
   Dir *last_collision;
@@ -501,6 +563,8 @@ struct CacheVC : public CacheVConnection {
       unsigned int hit_evacuate : 1;
       unsigned int compressed_in_ram : 1; // compressed state in ram cache
       unsigned int allow_empty_doc : 1;   // used for cache empty http document
+      unsigned int doc_from_tier : 1;     // read from the fast tier, may have been overwritten since
+      unsigned int tier_bypass : 1;       // read from the volume even if the fast tier has a copy
     } f;
   };
   // BTF optimization used to skip reading stuff in cache partition that doesn't contain any
@@ -980,6 +1044,7 @@ struct Cache {
   CacheHostTable *hosttable;
   int total_initialized_vol;
   CacheType scheme;
+  ink_mutex vol_init_mutex;
 
   int open(bool reconfigure, bool fix);
   int close();
@@ -1004,7 +1069,7 @@ struct Cache {
                int host_len);
   Action *deref(Continuation *cont, const CacheKey *key, CacheFragType type, const char *hostname, int host_len);
 
-  void vol_initialized(bool result);
+  void vol_initialized(Vol *vol, bool result);
 
   int open_done();
 
@@ -1020,6 +1085,7 @@ struct Cache {
       total_initialized_vol(0),
       scheme(CACHE_NONE_TYPE)
   {
+    ink_mutex_init(&vol_init_mutex);
   }
 };
 
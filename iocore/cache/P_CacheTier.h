@@ -0,0 +1,104 @@
+/** @file
+
+  A fast (SSD) tier in front of the cache volumes.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "P_CountMinSketch.h"
+#include "ts/List.h"
+#include <unordered_map>
+
+struct Vol;
+struct Doc;
+struct Dir;
+struct CacheTierWrite;
+
+/** A fragment on a volume, it is only the same fragment while it is at the same place.
+
+    The same key can be written to the same place again once the volume has wrapped, the phase
+    tells the two writes apart.
+ */
+struct CacheTierKey {
+  Vol *vol;
+  CryptoHash key;
+  uint64_t offset; ///< dir_offset() of the fragment in @a vol.
+  int phase;       ///< dir_phase() of the fragment.
+
+  bool
+  operator==(const CacheTierKey &that) const
+  {
+    return vol == that.vol && offset == that.offset && phase == that.phase && key == that.key;
+  }
+};
+
+struct CacheTierKeyHash {
+  size_t
+  operator()(const CacheTierKey &k) const
+  {
+    return k.key.fold() ^ (k.offset << 1 | k.phase);
+  }
+};
+
+struct CacheTierEntry {
+  CacheTierKey key;
+  int64_t offset;                 ///< Where the copy is in the tier.
+  uint32_t len;                   ///< Bytes used in the tier.
+  CacheTierWrite *write;          ///< Copy in progress, not readable until it is done.
+  LINK(CacheTierEntry, log_link); ///< In the order written.
+};
+
+/** Copies of often read fragments on a faster device.
+
+    Fragments read from the volumes more than @c proxy.config.cache.tier.promote_hits times
+    recently are copied to the tier and later reads of them are served from there. The tier is
+    written as a log, the oldest fragments are demoted when the space is needed, but only if the
+    new fragment is read more often than all of the ones it would displace together, so a large
+    fragment does not push out many small popular ones.
+
+    The index is in memory, the tier starts empty.
+ */
+struct CacheTier {
+  Ptr<ProxyMutex> mutex;
+  ats_scoped_str path;
+  int fd;
+  int64_t size;
+  int64_t write_pos  = 0;
+  int64_t bytes_used = 0;
+  CountMinSketch sketch; ///< Reads from the volumes.
+  std::unordered_map<CacheTierKey, CacheTierEntry *, CacheTierKeyHash> index;
+  Que(CacheTierEntry, log_link) log;
+
+  /// Where the copy of a fragment is, false if there is none that can be read.
+  bool lookup(Vol *vol, const CryptoHash *key, const Dir *dir, int64_t &tier_offset, uint32_t &len);
+  /// Count a read of a fragment from @a vol and copy it to the tier if it is popular enough.
+  void promote(Vol *vol, const CryptoHash *key, const Dir *dir, Doc *doc);
+  void write_done(CacheTierWrite *w);
+
+  CacheTier(const char *apath, int afd, int64_t asize);
+
+private:
+  void demote(CacheTierEntry *e);
+};
+
+extern CacheTier *cache_tier;
+
+void cache_tier_init();
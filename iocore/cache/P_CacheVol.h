@@ -37,6 +37,7 @@
 #define AGG_SIZE (4 * 1024 * 1024)     // 4MB
 #define AGG_HIGH_WATER (AGG_SIZE / 2)  // 2MB
 #define EVACUATION_SIZE (2 * AGG_SIZE) // 8MB
+#define AGG_MAX_BUFFERS 2              // writes in flight, recovery and sync writes only cover EVACUATION_SIZE
 #define MAX_VOL_SIZE ((off_t)512 * 1024 * 1024 * 1024 * 1024)
 #define STORE_BLOCKS_PER_CACHE_BLOCK (STORE_BLOCK_SIZE / CACHE_BLOCK_SIZE)
 #define MAX_VOL_BLOCKS (MAX_VOL_SIZE / CACHE_BLOCK_SIZE)
@@ -64,6 +65,7 @@
 #define DOC_MAGIC ((uint32_t)0x5F129B13)
 #define DOC_CORRUPT ((uint32_t)0xDEADBABE)
 #define DOC_NO_CHECKSUM ((uint32_t)0xA0B0C0D0)
+#define DOC_CRC32C_MINOR_VERSION 2 // docs older than 24.2 carry a byte sum instead of a CRC-32C
 
 struct Cache;
 struct Vol;
@@ -117,6 +119,19 @@ struct EvacuationBlock {
   LINK(EvacuationBlock, link);
 };
 
+// One of a stripe's aggregation buffers. While one buffer collects fragments the others can be on
+// their way to disk, the writes are retired in the order they were issued.
+struct AggBuffer : public Continuation {
+  Vol *vol     = nullptr;
+  char *buffer = nullptr;
+  bool done    = false; // write completed but an earlier one has not
+  AIOCallbackInternal io;
+
+  int handle_write_done(int event, void *data);
+
+  AggBuffer() : Continuation(nullptr) { SET_HANDLER(&AggBuffer::handle_write_done); }
+};
+
 struct Vol : public Continuation {
   char *path = nullptr;
   ats_scoped_str hash_text;
@@ -128,6 +143,7 @@ struct Vol : public Continuation {
   VolHeaderFooter *header = nullptr;
   VolHeaderFooter *footer = nullptr;
   int segments            = 0;
+  uint8_t *segment_dirty  = nullptr; // DIR_COPY_DIRTY bits, per segment
   off_t buckets           = 0;
   off_t recover_pos       = 0;
   off_t prev_recover_pos  = 0;
@@ -142,9 +158,13 @@ struct Vol : public Continuation {
   Queue<CacheVC, Continuation::Link_link> agg;
   Queue<CacheVC, Continuation::Link_link> stat_cache_vcs;
   Queue<CacheVC, Continuation::Link_link> sync;
-  char *agg_buffer  = nullptr;
-  int agg_todo_size = 0;
-  int agg_buf_pos   = 0;
+  AggBuffer *agg_bufs = nullptr; // ring of agg_buf_count buffers, the writes in flight start at agg_buf_head
+  int agg_buf_count   = 0;
+  int agg_buf_head    = 0;
+  int agg_writes      = 0;       // writes in flight
+  char *agg_buffer    = nullptr; // the buffer being filled, nullptr while all of them are in flight
+  int agg_todo_size   = 0;
+  int agg_buf_pos     = 0;
 
   Event *trigger = nullptr;
 
@@ -167,11 +187,19 @@ struct Vol : public Continuation {
   bool dir_sync_waiting      = false;
   bool dir_sync_in_progress  = false;
   bool writing_end_marker    = false;
+  bool ready                 = false; // directory loaded and recovered, the stripe takes requests
+  bool ram_cache_warming     = false; // the RAM cache is being loaded with the keys saved before a restart
 
   CacheKey first_fragment_key;
   int64_t first_fragment_offset = 0;
   Ptr<IOBufferData> first_fragment_data;
 
+  // Admission of new objects, see proxy.config.cache.admission.enabled. The sketch counts the
+  // attempts to write each new object, the window counts the bytes written in the current second.
+  CountMinSketch admission_sketch;
+  ink_hrtime admission_window    = 0;
+  int64_t admission_window_bytes = 0;
+
   void cancel_trigger();
 
   int recover_data();
@@ -225,9 +253,11 @@ struct Vol : public Continuation {
     io.aiocb.aio_fildes = AIO_NOT_IN_PROGRESS;
   }
 
-  int aggWriteDone(int event, Event *e);
+  int aggWriteDone(int event, AggBuffer *b);
   int aggWrite(int event, void *e);
   void agg_wrap();
+  AggBuffer *agg_write(int i); // the i-th oldest write in flight, i == agg_writes is the buffer being filled
+  char *agg_buffer_at(off_t pos);
 
   int evacuateWrite(CacheVC *evacuator, int event, Event *e);
   int evacuateDocReadDone(int event, Event *e);
@@ -254,6 +284,10 @@ struct Vol : public Continuation {
   int vol_in_phase_valid(Dir *e);
   int vol_in_phase_agg_buf_valid(Dir *e);
 
+  // segments that changed since a directory copy was last synced
+  void mark_segment_dirty(int s);
+  void mark_all_segments_dirty();
+
   off_t vol_offset(Dir *e);
   off_t offset_to_vol_offset(off_t pos);
   off_t vol_offset_to_offset(off_t pos);
@@ -262,12 +296,18 @@ struct Vol : public Continuation {
   Vol() : Continuation(new_ProxyMutex())
   {
     open_dir.mutex = mutex;
-    agg_buffer     = (char *)ats_memalign(ats_pagesize(), AGG_SIZE);
-    memset(agg_buffer, 0, AGG_SIZE);
     SET_HANDLER(&Vol::aggWrite);
   }
 
-  ~Vol() override { ats_memalign_free(agg_buffer); }
+  ~Vol() override
+  {
+    for (int i = 0; i < agg_buf_count; i++) {
+      ink_aio_unregister_buffer(agg_bufs[i].buffer);
+      ats_memalign_free(agg_bufs[i].buffer);
+    }
+    delete[] agg_bufs;
+    ats_free(segment_dirty);
+  }
 };
 
 struct AIO_Callback_handler : public Continuation {
@@ -323,6 +363,7 @@ struct Doc {
   int no_data_in_fragment();
   char *hdr();
   char *data();
+  uint32_t compute_checksum();
 };
 
 // Global Data
@@ -348,6 +389,18 @@ Vol::dir_segment(int s)
   return (Dir *)(((char *)this->dir) + (s * this->buckets) * DIR_DEPTH * SIZEOF_DIR);
 }
 
+TS_INLINE void
+Vol::mark_segment_dirty(int s)
+{
+  this->segment_dirty[s] = DIR_COPY_DIRTY_ALL;
+}
+
+TS_INLINE void
+Vol::mark_all_segments_dirty()
+{
+  memset(this->segment_dirty, DIR_COPY_DIRTY_ALL, this->segments);
+}
+
 TS_INLINE size_t
 Vol::dirlen()
 {
@@ -382,7 +435,7 @@ Vol::vol_out_of_phase_write_valid(Dir *e)
 TS_INLINE int
 Vol::vol_in_phase_valid(Dir *e)
 {
-  return (dir_offset(e) - 1 < ((this->header->write_pos + this->agg_buf_pos - this->start) / CACHE_BLOCK_SIZE));
+  return (dir_offset(e) - 1 < ((this->header->agg_pos + this->agg_buf_pos - this->start) / CACHE_BLOCK_SIZE));
 }
 
 TS_INLINE off_t
@@ -406,7 +459,27 @@ Vol::vol_offset_to_offset(off_t pos)
 TS_INLINE int
 Vol::vol_in_phase_agg_buf_valid(Dir *e)
 {
-  return (this->vol_offset(e) >= this->header->write_pos && this->vol_offset(e) < (this->header->write_pos + this->agg_buf_pos));
+  return (this->vol_offset(e) >= this->header->write_pos && this->vol_offset(e) < (this->header->agg_pos + this->agg_buf_pos));
+}
+
+TS_INLINE AggBuffer *
+Vol::agg_write(int i)
+{
+  return &this->agg_bufs[(this->agg_buf_head + i) % this->agg_buf_count];
+}
+
+// Returns the copy in memory of the data at pos, which must be past write_pos and before the end of the
+// data aggregated so far. The writes in flight are contiguous from write_pos, the buffer being filled follows.
+TS_INLINE char *
+Vol::agg_buffer_at(off_t pos)
+{
+  for (int i = 0; i < this->agg_writes; i++) {
+    AggBuffer *b = this->agg_write(i);
+    if (pos < b->io.aiocb.aio_offset + (off_t)b->io.aiocb.aio_nbytes) {
+      return b->buffer + (pos - b->io.aiocb.aio_offset);
+    }
+  }
+  return this->agg_buffer + (pos - this->header->agg_pos);
 }
 // length of the partition not including the offset of location 0.
 TS_INLINE off_t
@@ -0,0 +1,135 @@
+/** @file
+
+  Count-Min sketch of recent access frequency, keyed by cache key.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "ts/ink_memory.h"
+#include "ts/CryptoHash.h"
+
+/** Approximate access counts for cache keys.
+
+    Each key maps to one counter in each of @c DEPTH rows and its frequency is the smallest of
+    them, so a count can only be over estimated by collisions. Counters saturate at @c MAX_COUNT
+    and once @c SAMPLE_FACTOR increments per column have been made every counter is halved, so
+    the sketch follows the recent popularity of keys rather than their all time count.
+
+    Not thread safe, callers provide the locking.
+ */
+struct CountMinSketch {
+  static const int DEPTH          = 4;
+  static const uint8_t MAX_COUNT  = 15;
+  static const int SAMPLE_FACTOR  = 10;
+  static const uint32_t MIN_WIDTH = 1024;
+  static const uint32_t MAX_WIDTH = 1 << 24;
+
+  uint8_t *table       = nullptr;
+  uint32_t width       = 0; ///< Counters per row, a power of 2.
+  uint32_t additions   = 0; ///< Increments since the last halving.
+  uint32_t sample_size = 0;
+
+  /// Size the sketch for about @a items distinct keys, discarding any counts.
+  void
+  init(uint64_t items)
+  {
+    uint32_t w = MIN_WIDTH;
+    while (w < items && w < MAX_WIDTH) {
+      w <<= 1;
+    }
+    ats_free(table);
+    width       = w;
+    additions   = 0;
+    sample_size = w * SAMPLE_FACTOR;
+    table       = static_cast<uint8_t *>(ats_malloc(DEPTH * width));
+    memset(table, 0, DEPTH * width);
+  }
+
+  uint8_t
+  frequency(const CryptoHash *key) const
+  {
+    uint32_t h1, h2;
+    uint8_t f = MAX_COUNT;
+
+    hash(key, h1, h2);
+    for (int i = 0; i < DEPTH; ++i) {
+      uint8_t c = table[i * width + ((h1 + i * h2) & (width - 1))];
+      if (c < f) {
+        f = c;
+      }
+    }
+    return f;
+  }
+
+  /// Count an access to @a key. Only the counters holding the minimum are raised (conservative update).
+  void
+  increment(const CryptoHash *key)
+  {
+    uint8_t *c[DEPTH];
+    uint32_t h1, h2;
+    uint8_t f = MAX_COUNT;
+
+    hash(key, h1, h2);
+    for (int i = 0; i < DEPTH; ++i) {
+      c[i] = &table[i * width + ((h1 + i * h2) & (width - 1))];
+      if (*c[i] < f) {
+        f = *c[i];
+      }
+    }
+    if (f == MAX_COUNT) {
+      return;
+    }
+    for (int i = 0; i < DEPTH; ++i) {
+      if (*c[i] == f) {
+        ++*c[i];
+      }
+    }
+    if (++additions >= sample_size) {
+      age();
+    }
+  }
+
+  /// Halve every counter.
+  void
+  age()
+  {
+    for (uint32_t i = 0; i < DEPTH * width; ++i) {
+      table[i] >>= 1;
+    }
+    additions /= 2;
+  }
+
+  ~CountMinSketch() { ats_free(table); }
+
+private:
+  // Row i uses h1 + i * h2, which is as good as independent hashes for this purpose. The key is
+  // mixed first as test and synthetic keys are not uniformly distributed.
+  static void
+  hash(const CryptoHash *key, uint32_t &h1, uint32_t &h2)
+  {
+    uint64_t h = key->u64[0] * 0x9e3779b97f4a7c15ULL + key->u64[1];
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h1 = static_cast<uint32_t>(h);
+    h2 = static_cast<uint32_t>(h >> 32) | 1;
+  }
+};
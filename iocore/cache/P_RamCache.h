@@ -24,9 +24,16 @@
 #pragma once
 
 #include "I_Cache.h"
+#include <vector>
 
 // Generic Ram Cache interface
 
+struct RamCacheKey {
+  CryptoHash key;
+  uint32_t auxkey1;
+  uint32_t auxkey2;
+};
+
 struct RamCache {
   // returns 1 on found/stored, 0 on not found/stored, if provided auxkey1 and auxkey2 must match
   virtual int get(CryptoHash *key, Ptr<IOBufferData> *ret_data, uint32_t auxkey1 = 0, uint32_t auxkey2 = 0) = 0;
@@ -35,6 +42,8 @@ struct RamCache {
   virtual int fixup(const CryptoHash *key, uint32_t old_auxkey1, uint32_t old_auxkey2, uint32_t new_auxkey1,
                     uint32_t new_auxkey2)                                                                   = 0;
   virtual int64_t size() const                                                                              = 0;
+  // appends the keys of the cached objects, most valuable first
+  virtual void hot_keys(std::vector<RamCacheKey> &keys) const = 0;
 
   virtual void init(int64_t max_bytes, Vol *vol) = 0;
   virtual ~RamCache(){};
@@ -42,3 +51,8 @@ struct RamCache {
 
 RamCache *new_RamCacheLRU();
 RamCache *new_RamCacheCLFUS();
+RamCache *new_RamCacheTinyLFU();
+
+// Saving the RAM cache keys and loading the objects back in after a restart
+void start_ram_cache_persist();
+void start_ram_cache_warm(Vol *vol);
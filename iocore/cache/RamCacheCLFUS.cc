@@ -33,12 +33,23 @@
 #ifdef HAVE_LZMA_H
 #include <lzma.h>
 #endif
+#ifdef HAVE_ZSTD_H
+#include <zstd.h>
+#include <zdict.h>
+#endif
+#include <algorithm>
+#include <string>
+#include <vector>
 
 #define REQUIRED_COMPRESSION 0.9 // must get to this size or declared incompressible
 #define REQUIRED_SHRINK 0.8      // must get to this size or keep orignal buffer (with padding)
 #define HISTORY_HYSTERIA 10      // extra temporary history
 #define ENTRY_OVERHEAD 256       // per-entry overhead to consider when computing cache value/size
 #define LZMA_BASE_MEMLIMIT (64 * 1024 * 1024)
+#define ZSTD_LEVEL_RAM_CACHE 1                 // favor speed, the dictionary makes up much of the ratio
+#define ZSTD_DICT_SAMPLE_SIZE 4096             // bytes taken from the start of each entry to train the dictionary
+#define ZSTD_DICT_SAMPLE_RATIO 100             // train once the samples are this many times the dictionary size
+#define ZSTD_DICT_SAMPLE_MAX (8 * 1024 * 1024) // but never collect more samples than this
 //#define CHECK_ACOUNTING 1 // very expensive double checking of all sizes
 
 #define REQUEUE_HITS(_h) ((_h) ? ((_h)-1) : 0)
@@ -48,6 +59,25 @@
 #define AVERAGE_VALUE_OVER 100
 #define REQUEUE_LIMIT 100
 
+// Statistics for each compression type, indexed by CACHE_COMPRESSION_*
+static const struct {
+  int bytes_in;
+  int bytes_out;
+  int compress_time;
+  int hits;
+  int decompress_time;
+} compress_stats[] = {
+  {0, 0, 0, 0, 0}, // CACHE_COMPRESSION_NONE
+  {cache_ram_cache_fastlz_bytes_in_stat, cache_ram_cache_fastlz_bytes_out_stat, cache_ram_cache_fastlz_compress_time_stat,
+   cache_ram_cache_fastlz_hits_stat, cache_ram_cache_fastlz_decompress_time_stat},
+  {cache_ram_cache_libz_bytes_in_stat, cache_ram_cache_libz_bytes_out_stat, cache_ram_cache_libz_compress_time_stat,
+   cache_ram_cache_libz_hits_stat, cache_ram_cache_libz_decompress_time_stat},
+  {cache_ram_cache_liblzma_bytes_in_stat, cache_ram_cache_liblzma_bytes_out_stat, cache_ram_cache_liblzma_compress_time_stat,
+   cache_ram_cache_liblzma_hits_stat, cache_ram_cache_liblzma_decompress_time_stat},
+  {cache_ram_cache_zstd_bytes_in_stat, cache_ram_cache_zstd_bytes_out_stat, cache_ram_cache_zstd_compress_time_stat,
+   cache_ram_cache_zstd_hits_stat, cache_ram_cache_zstd_decompress_time_stat},
+};
+
 struct RamCacheCLFUSEntry {
   CryptoHash key;
   uint32_t auxkey1;
@@ -81,6 +111,7 @@ struct RamCacheCLFUS : public RamCache {
           uint32_t auxkey2 = 0) override;
   int fixup(const CryptoHash *key, uint32_t old_auxkey1, uint32_t old_auxkey2, uint32_t new_auxkey1, uint32_t new_auxkey2) override;
   int64_t size() const override;
+  void hot_keys(std::vector<RamCacheKey> &keys) const override;
 
   void init(int64_t max_bytes, Vol *vol) override;
 
@@ -102,6 +133,16 @@ struct RamCacheCLFUS : public RamCache {
   RamCacheCLFUSEntry *destroy(RamCacheCLFUSEntry *e);
   void requeue_victims(Que(RamCacheCLFUSEntry, lru_link) & victims);
   void tick(); // move CLOCK on history
+#ifdef HAVE_ZSTD_H
+  ZSTD_CCtx *zstd_cctx   = nullptr; // only used by the compressor
+  ZSTD_CDict *zstd_cdict = nullptr; // only used by the compressor
+  ZSTD_DCtx *zstd_dctx   = nullptr;
+  ZSTD_DDict *zstd_ddict = nullptr;
+  std::string zstd_samples;              // only used by the compressor
+  std::vector<size_t> zstd_sample_sizes; // only used by the compressor
+  bool zstd_sampled = false;             // the samples were handed to the trainer
+  void zstd_sample(const char *data, uint32_t len);
+#endif
   RamCacheCLFUS()
     : max_bytes(0),
       bytes(0),
@@ -136,6 +177,19 @@ RamCacheCLFUS::size() const
   return s;
 }
 
+void
+RamCacheCLFUS::hot_keys(std::vector<RamCacheKey> &keys) const
+{
+  // lru[1] is history and holds no data
+  std::vector<const RamCacheCLFUSEntry *> entries;
+  forl_LL(RamCacheCLFUSEntry, e, lru[0]) { entries.push_back(e); }
+  std::stable_sort(entries.begin(), entries.end(),
+                   [](const RamCacheCLFUSEntry *a, const RamCacheCLFUSEntry *b) { return CACHE_VALUE(a) > CACHE_VALUE(b); });
+  for (auto e : entries) {
+    keys.push_back({e->key, e->auxkey1, e->auxkey2});
+  }
+}
+
 class RamCacheCLFUSCompressor : public Continuation
 {
 public:
@@ -162,6 +216,11 @@ RamCacheCLFUSCompressor::mainEvent(int /* event ATS_UNUSED */, Event *e)
   case CACHE_COMPRESSION_LIBLZMA:
 #ifndef HAVE_LZMA_H
     Warning("lzma not available for RAM cache compression");
+#endif
+    break;
+  case CACHE_COMPRESSION_ZSTD:
+#ifndef HAVE_ZSTD_H
+    Warning("zstd not available for RAM cache compression");
 #endif
     break;
   }
@@ -171,6 +230,44 @@ RamCacheCLFUSCompressor::mainEvent(int /* event ATS_UNUSED */, Event *e)
   return EVENT_CONT;
 }
 
+#ifdef HAVE_ZSTD_H
+// Trains the zstd dictionary of a volume once, as a task of its own so the compressor keeps going.
+class RamCacheCLFUSTrainer : public Continuation
+{
+public:
+  RamCacheCLFUS *rc;
+  std::string samples;
+  std::vector<size_t> sample_sizes;
+  int mainEvent(int event, Event *e);
+
+  RamCacheCLFUSTrainer(RamCacheCLFUS *arc) : rc(arc) { SET_HANDLER(&RamCacheCLFUSTrainer::mainEvent); }
+};
+
+int
+RamCacheCLFUSTrainer::mainEvent(int /* event ATS_UNUSED */, Event *e)
+{
+  size_t dict_size = cache_config_ram_cache_zstd_dict_size;
+  void *dict       = ats_malloc(dict_size);
+  size_t dlen      = ZDICT_trainFromBuffer(dict, dict_size, samples.data(), sample_sizes.data(), sample_sizes.size());
+
+  if (ZDICT_isError(dlen)) {
+    Warning("unable to train a RAM cache compression dictionary for %s: %s", rc->vol->hash_text.get(), ZDICT_getErrorName(dlen));
+  } else {
+    Debug("ram_cache", "trained a %zu byte dictionary for %s from %zu samples", dlen, rc->vol->hash_text.get(),
+          sample_sizes.size());
+    ZSTD_DDict *ddict = ZSTD_createDDict(dict, dlen);
+    ZSTD_CDict *cdict = ZSTD_createCDict(dict, dlen, ZSTD_LEVEL_RAM_CACHE);
+    MUTEX_TAKE_LOCK(rc->vol->mutex, e->ethread);
+    rc->zstd_ddict = ddict;
+    rc->zstd_cdict = cdict;
+    MUTEX_UNTAKE_LOCK(rc->vol->mutex, e->ethread);
+  }
+  ats_free(dict);
+  delete this;
+  return EVENT_DONE;
+}
+#endif
+
 ClassAllocator<RamCacheCLFUSEntry> ramCacheCLFUSEntryAllocator("RamCacheCLFUSEntry");
 
 static const int bucket_sizes[] = {127,      251,      509,       1021,      2039,      4093,       8191,      16381,   32749,
@@ -215,6 +312,12 @@ RamCacheCLFUS::init(int64_t abytes, Vol *avol)
     return;
   }
   resize_hashtable();
+#ifdef HAVE_ZSTD_H
+  if (cache_config_ram_cache_compress == CACHE_COMPRESSION_ZSTD) {
+    zstd_cctx = ZSTD_createCCtx();
+    zstd_dctx = ZSTD_createDCtx();
+  }
+#endif
   if (cache_config_ram_cache_compress) {
     eventProcessor.schedule_every(new RamCacheCLFUSCompressor(this), HRTIME_SECOND, ET_TASK);
   }
@@ -264,7 +367,8 @@ RamCacheCLFUS::get(CryptoHash *key, Ptr<IOBufferData> *ret_data, uint32_t auxkey
         e->hits++;
         uint32_t ram_hit_state = RAM_HIT_COMPRESS_NONE;
         if (e->flag_bits.compressed) {
-          b = (char *)ats_malloc(e->len);
+          b                = (char *)ats_malloc(e->len);
+          ink_hrtime start = Thread::get_hrtime_updated();
           switch (e->flag_bits.compressed) {
           default:
             goto Lfailed;
@@ -298,7 +402,21 @@ RamCacheCLFUS::get(CryptoHash *key, Ptr<IOBufferData> *ret_data, uint32_t auxkey
             break;
           }
 #endif
+#ifdef HAVE_ZSTD_H
+          case CACHE_COMPRESSION_ZSTD: {
+            // Entries compressed before the dictionary was trained do not use it.
+            const ZSTD_DDict *ddict = ZSTD_getDictID_fromFrame(e->data->data(), e->compressed_len) ? zstd_ddict : nullptr;
+            size_t l                = ZSTD_decompress_usingDDict(zstd_dctx, b, e->len, e->data->data(), e->compressed_len, ddict);
+            if (ZSTD_isError(l) || l != e->len) {
+              goto Lfailed;
+            }
+            ram_hit_state = RAM_HIT_COMPRESS_ZSTD;
+            break;
           }
+#endif
+          }
+          CACHE_SUM_DYN_STAT_THREAD(compress_stats[e->flag_bits.compressed].hits, 1);
+          CACHE_SUM_DYN_STAT_THREAD(compress_stats[e->flag_bits.compressed].decompress_time, Thread::get_hrtime_updated() - start);
           IOBufferData *data = new_xmalloc_IOBufferData(b, e->len);
           data->_mem_type    = DEFAULT_ALLOC;
           if (!e->flag_bits.copy) { // don't bother if we have to copy anyway
@@ -460,15 +578,24 @@ RamCacheCLFUS::compress_entries(EThread *thread, int do_at_most)
       case CACHE_COMPRESSION_LIBLZMA:
         l = e->len;
         break;
+#endif
+#ifdef HAVE_ZSTD_H
+      case CACHE_COMPRESSION_ZSTD:
+        l = (uint32_t)ZSTD_compressBound(e->len);
+        break;
 #endif
       }
       // store transient data for lock release
       Ptr<IOBufferData> edata = e->data;
       uint32_t elen           = e->len;
       CryptoHash key          = e->key;
+#ifdef HAVE_ZSTD_H
+      ZSTD_CDict *cdict = zstd_cdict; // set by the trainer under the volume lock
+#endif
       MUTEX_UNTAKE_LOCK(vol->mutex, thread);
-      b           = (char *)ats_malloc(l);
-      bool failed = false;
+      b                = (char *)ats_malloc(l);
+      bool failed      = false;
+      ink_hrtime start = Thread::get_hrtime_updated();
       switch (ctype) {
       default:
         goto Lfailed;
@@ -501,7 +628,28 @@ RamCacheCLFUS::compress_entries(EThread *thread, int do_at_most)
         break;
       }
 #endif
+#ifdef HAVE_ZSTD_H
+      case CACHE_COMPRESSION_ZSTD: {
+        size_t ll = cdict ? ZSTD_compress_usingCDict(zstd_cctx, b, l, edata->data(), elen, cdict) :
+                            ZSTD_compressCCtx(zstd_cctx, b, l, edata->data(), elen, ZSTD_LEVEL_RAM_CACHE);
+        if (ZSTD_isError(ll)) {
+          failed = true;
+        }
+        l = (uint32_t)ll;
+        break;
+      }
+#endif
+      }
+      if (!failed) {
+        CACHE_SUM_DYN_STAT_THREAD(compress_stats[ctype].bytes_in, elen);
+        CACHE_SUM_DYN_STAT_THREAD(compress_stats[ctype].bytes_out, l);
+        CACHE_SUM_DYN_STAT_THREAD(compress_stats[ctype].compress_time, Thread::get_hrtime_updated() - start);
       }
+#ifdef HAVE_ZSTD_H
+      if (ctype == CACHE_COMPRESSION_ZSTD && !zstd_sampled && cache_config_ram_cache_zstd_dict_size) {
+        zstd_sample(edata->data(), elen);
+      }
+#endif
       MUTEX_TAKE_LOCK(vol->mutex, thread);
       // see if the entry is till around
       {
@@ -570,6 +718,29 @@ RamCacheCLFUS::compress_entries(EThread *thread, int do_at_most)
   return;
 }
 
+#ifdef HAVE_ZSTD_H
+// Collect the start of entries being compressed and once there is enough, hand them to a task that
+// trains a dictionary for this volume. Called by the compressor without the volume lock.
+void
+RamCacheCLFUS::zstd_sample(const char *data, uint32_t len)
+{
+  size_t n      = std::min<size_t>(len, ZSTD_DICT_SAMPLE_SIZE);
+  size_t wanted = std::min<size_t>(cache_config_ram_cache_zstd_dict_size * ZSTD_DICT_SAMPLE_RATIO, ZSTD_DICT_SAMPLE_MAX);
+
+  zstd_samples.append(data, n);
+  zstd_sample_sizes.push_back(n);
+  if (zstd_samples.size() < wanted) {
+    return;
+  }
+
+  RamCacheCLFUSTrainer *trainer = new RamCacheCLFUSTrainer(this);
+  trainer->samples.swap(zstd_samples);
+  trainer->sample_sizes.swap(zstd_sample_sizes);
+  zstd_sampled = true;
+  eventProcessor.schedule_imm(trainer, ET_TASK);
+}
+#endif
+
 void RamCacheCLFUS::requeue_victims(Que(RamCacheCLFUSEntry, lru_link) & victims)
 {
   RamCacheCLFUSEntry *victim = nullptr;
@@ -0,0 +1,333 @@
+/** @file
+
+  A brief file description
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+// Window TinyLFU replacement policy
+// See Einziger, Friedman and Manes, "TinyLFU: A Highly Efficient Cache Admission Policy"
+//
+// New objects go into a small LRU window. Objects pushed out of the window are only admitted to
+// the main cache, a segmented LRU, if they have been requested more often recently than the
+// object they would displace. Access frequency is kept in a Count-Min sketch, so one time
+// requests such as a crawl or scan of the content cannot flush popular objects.
+
+#include "P_Cache.h"
+#include "P_CountMinSketch.h"
+
+#define ENTRY_OVERHEAD 128           // per-entry overhead to consider when computing sizes
+#define WINDOW_PERCENT 1             // share of the cache given to the window
+#define PROTECTED_PERCENT 80         // share of the main cache given to the protected segment
+#define SKETCH_BYTES_PER_OBJECT 4096 // used to estimate how many objects the cache will hold
+
+#define ENTRY_SIZE(_e) (ENTRY_OVERHEAD + (_e)->data->block_size())
+
+enum RamCacheTinyLFUSegment {
+  TINYLFU_WINDOW,
+  TINYLFU_PROBATION,
+  TINYLFU_PROTECTED,
+  TINYLFU_SEGMENTS,
+};
+
+struct RamCacheTinyLFUEntry {
+  CryptoHash key;
+  uint32_t auxkey1;
+  uint32_t auxkey2;
+  uint32_t segment;
+  LINK(RamCacheTinyLFUEntry, lru_link);
+  LINK(RamCacheTinyLFUEntry, hash_link);
+  Ptr<IOBufferData> data;
+};
+
+struct RamCacheTinyLFU : public RamCache {
+  int64_t max_bytes = 0;
+  int64_t bytes     = 0;
+  int64_t objects   = 0;
+
+  // returns 1 on found/stored, 0 on not found/stored, if provided auxkey1 and auxkey2 must match
+  int get(CryptoHash *key, Ptr<IOBufferData> *ret_data, uint32_t auxkey1 = 0, uint32_t auxkey2 = 0) override;
+  int put(CryptoHash *key, IOBufferData *data, uint32_t len, bool copy = false, uint32_t auxkey1 = 0,
+          uint32_t auxkey2 = 0) override;
+  int fixup(const CryptoHash *key, uint32_t old_auxkey1, uint32_t old_auxkey2, uint32_t new_auxkey1, uint32_t new_auxkey2) override;
+  int64_t size() const override;
+  void hot_keys(std::vector<RamCacheKey> &keys) const override;
+
+  void init(int64_t max_bytes, Vol *vol) override;
+
+  // private
+  int64_t max_window    = 0;
+  int64_t max_main      = 0;
+  int64_t max_protected = 0;
+  Que(RamCacheTinyLFUEntry, lru_link) lru[TINYLFU_SEGMENTS];
+  int64_t lru_bytes[TINYLFU_SEGMENTS] = {0, 0, 0};
+  CountMinSketch sketch;
+  DList(RamCacheTinyLFUEntry, hash_link) *bucket = nullptr;
+  int nbuckets                                   = 0;
+  int ibuckets                                   = 0;
+  Vol *vol                                       = nullptr;
+
+  void resize_hashtable();
+  void link(RamCacheTinyLFUEntry *e, int segment);
+  void unlink(RamCacheTinyLFUEntry *e);
+  void touch(RamCacheTinyLFUEntry *e);
+  bool admit(RamCacheTinyLFUEntry *e);
+  RamCacheTinyLFUEntry *remove(RamCacheTinyLFUEntry *e);
+};
+
+int64_t
+RamCacheTinyLFU::size() const
+{
+  int64_t s = 0;
+  for (auto &q : lru) {
+    forl_LL(RamCacheTinyLFUEntry, e, q)
+    {
+      s += sizeof(*e);
+      s += sizeof(*e->data);
+      s += e->data->block_size();
+    }
+  }
+  return s;
+}
+
+void
+RamCacheTinyLFU::hot_keys(std::vector<RamCacheKey> &keys) const
+{
+  // objects that have been hit in the main cache first, new arrivals last
+  static const int order[] = {TINYLFU_PROTECTED, TINYLFU_PROBATION, TINYLFU_WINDOW};
+  for (int segment : order) {
+    for (RamCacheTinyLFUEntry *e = lru[segment].tail; e; e = lru[segment].prev(e)) {
+      keys.push_back({e->key, e->auxkey1, e->auxkey2});
+    }
+  }
+}
+
+ClassAllocator<RamCacheTinyLFUEntry> ramCacheTinyLFUEntryAllocator("RamCacheTinyLFUEntry");
+
+static const int bucket_sizes[] = {127,     251,      509,      1021,     2039,      4093,      8191,     16381,
+                                   32749,   65521,    131071,   262139,   524287,    1048573,   2097143,  4194301,
+                                   8388593, 16777213, 33554393, 67108859, 134217689, 268435399, 536870909};
+
+void
+RamCacheTinyLFU::resize_hashtable()
+{
+  int anbuckets = bucket_sizes[ibuckets];
+  DDebug("ram_cache", "resize hashtable %d", anbuckets);
+  int64_t s                                          = anbuckets * sizeof(DList(RamCacheTinyLFUEntry, hash_link));
+  DList(RamCacheTinyLFUEntry, hash_link) *new_bucket = (DList(RamCacheTinyLFUEntry, hash_link) *)ats_malloc(s);
+  memset(static_cast<void *>(new_bucket), 0, s);
+  if (bucket) {
+    for (int64_t i = 0; i < nbuckets; i++) {
+      RamCacheTinyLFUEntry *e = nullptr;
+      while ((e = bucket[i].pop())) {
+        new_bucket[e->key.slice32(3) % anbuckets].push(e);
+      }
+    }
+    ats_free(bucket);
+  }
+  bucket   = new_bucket;
+  nbuckets = anbuckets;
+}
+
+void
+RamCacheTinyLFU::init(int64_t abytes, Vol *avol)
+{
+  vol           = avol;
+  max_bytes     = abytes;
+  max_window    = max_bytes * WINDOW_PERCENT / 100;
+  max_main      = max_bytes - max_window;
+  max_protected = max_main * PROTECTED_PERCENT / 100;
+  DDebug("ram_cache", "initializing ram_cache %" PRId64 " bytes", abytes);
+  if (!max_bytes) {
+    return;
+  }
+  // Keys are only compared against keys that fit in the cache, so the sketch need not be much
+  // wider than the number of objects.
+  sketch.init(max_bytes / SKETCH_BYTES_PER_OBJECT);
+  resize_hashtable();
+}
+
+void
+RamCacheTinyLFU::link(RamCacheTinyLFUEntry *e, int segment)
+{
+  e->segment = segment;
+  lru[segment].enqueue(e);
+  lru_bytes[segment] += ENTRY_SIZE(e);
+}
+
+void
+RamCacheTinyLFU::unlink(RamCacheTinyLFUEntry *e)
+{
+  lru[e->segment].remove(e);
+  lru_bytes[e->segment] -= ENTRY_SIZE(e);
+}
+
+// A hit in probation promotes the entry to protected, which pushes the least recently used
+// protected entries back to probation.
+void
+RamCacheTinyLFU::touch(RamCacheTinyLFUEntry *e)
+{
+  int segment = e->segment == TINYLFU_PROBATION ? TINYLFU_PROTECTED : e->segment;
+
+  unlink(e);
+  link(e, segment);
+  while (lru_bytes[TINYLFU_PROTECTED] > max_protected) {
+    RamCacheTinyLFUEntry *ee = lru[TINYLFU_PROTECTED].head;
+    unlink(ee);
+    link(ee, TINYLFU_PROBATION);
+  }
+}
+
+// Move the window entry @a e to the main cache if it is wanted more than whatever it displaces.
+bool
+RamCacheTinyLFU::admit(RamCacheTinyLFUEntry *e)
+{
+  int64_t size = ENTRY_SIZE(e);
+  int freq     = -1;
+
+  while (lru_bytes[TINYLFU_PROBATION] + lru_bytes[TINYLFU_PROTECTED] + size > max_main) {
+    RamCacheTinyLFUEntry *victim = lru[TINYLFU_PROBATION].head ? lru[TINYLFU_PROBATION].head : lru[TINYLFU_PROTECTED].head;
+    if (!victim) {
+      return false;
+    }
+    if (freq < 0) {
+      freq = sketch.frequency(&e->key);
+    }
+    if (freq <= sketch.frequency(&victim->key)) {
+      DDebug("ram_cache", "put %X %d %d REJECTED", e->key.slice32(3), e->auxkey1, e->auxkey2);
+      return false;
+    }
+    remove(victim);
+  }
+  unlink(e);
+  link(e, TINYLFU_PROBATION);
+  return true;
+}
+
+int
+RamCacheTinyLFU::get(CryptoHash *key, Ptr<IOBufferData> *ret_data, uint32_t auxkey1, uint32_t auxkey2)
+{
+  if (!max_bytes) {
+    return 0;
+  }
+  sketch.increment(key);
+  uint32_t i              = key->slice32(3) % nbuckets;
+  RamCacheTinyLFUEntry *e = bucket[i].head;
+  while (e) {
+    if (e->key == *key && e->auxkey1 == auxkey1 && e->auxkey2 == auxkey2) {
+      touch(e);
+      (*ret_data) = e->data;
+      DDebug("ram_cache", "get %X %d %d HIT", key->slice32(3), auxkey1, auxkey2);
+      CACHE_SUM_DYN_STAT_THREAD(cache_ram_cache_hits_stat, 1);
+      return 1;
+    }
+    e = e->hash_link.next;
+  }
+  DDebug("ram_cache", "get %X %d %d MISS", key->slice32(3), auxkey1, auxkey2);
+  CACHE_SUM_DYN_STAT_THREAD(cache_ram_cache_misses_stat, 1);
+  return 0;
+}
+
+RamCacheTinyLFUEntry *
+RamCacheTinyLFU::remove(RamCacheTinyLFUEntry *e)
+{
+  RamCacheTinyLFUEntry *ret = e->hash_link.next;
+  uint32_t b                = e->key.slice32(3) % nbuckets;
+  bucket[b].remove(e);
+  unlink(e);
+  bytes -= ENTRY_SIZE(e);
+  CACHE_SUM_DYN_STAT_THREAD(cache_ram_cache_bytes_stat, -ENTRY_SIZE(e));
+  DDebug("ram_cache", "put %X %d %d FREED", e->key.slice32(3), e->auxkey1, e->auxkey2);
+  e->data = nullptr;
+  THREAD_FREE(e, ramCacheTinyLFUEntryAllocator, this_thread());
+  objects--;
+  return ret;
+}
+
+// ignore 'copy' since we don't touch the data
+// The sketch is not incremented here, a put follows the get that missed and that already counted.
+int
+RamCacheTinyLFU::put(CryptoHash *key, IOBufferData *data, uint32_t len, bool, uint32_t auxkey1, uint32_t auxkey2)
+{
+  if (!max_bytes) {
+    return 0;
+  }
+  uint32_t i              = key->slice32(3) % nbuckets;
+  RamCacheTinyLFUEntry *e = bucket[i].head;
+  while (e) {
+    if (e->key == *key) {
+      if (e->auxkey1 == auxkey1 && e->auxkey2 == auxkey2) {
+        touch(e);
+        return 1;
+      } else { // discard when aux keys conflict
+        e = remove(e);
+        continue;
+      }
+    }
+    e = e->hash_link.next;
+  }
+  e          = THREAD_ALLOC(ramCacheTinyLFUEntryAllocator, this_ethread());
+  e->key     = *key;
+  e->auxkey1 = auxkey1;
+  e->auxkey2 = auxkey2;
+  e->data    = data;
+  bucket[i].push(e);
+  link(e, TINYLFU_WINDOW);
+  bytes += ENTRY_SIZE(e);
+  objects++;
+  CACHE_SUM_DYN_STAT_THREAD(cache_ram_cache_bytes_stat, ENTRY_SIZE(e));
+  DDebug("ram_cache", "put %X %d %d len %d INSERTED", key->slice32(3), auxkey1, auxkey2, len);
+  while (lru_bytes[TINYLFU_WINDOW] > max_window) {
+    RamCacheTinyLFUEntry *ee = lru[TINYLFU_WINDOW].head;
+    if (!admit(ee)) {
+      remove(ee);
+    }
+  }
+  if (objects > nbuckets) {
+    ++ibuckets;
+    resize_hashtable();
+  }
+  return 1;
+}
+
+int
+RamCacheTinyLFU::fixup(const CryptoHash *key, uint32_t old_auxkey1, uint32_t old_auxkey2, uint32_t new_auxkey1,
+                       uint32_t new_auxkey2)
+{
+  if (!max_bytes) {
+    return 0;
+  }
+  uint32_t i              = key->slice32(3) % nbuckets;
+  RamCacheTinyLFUEntry *e = bucket[i].head;
+  while (e) {
+    if (e->key == *key && e->auxkey1 == old_auxkey1 && e->auxkey2 == old_auxkey2) {
+      e->auxkey1 = new_auxkey1;
+      e->auxkey2 = new_auxkey2;
+      return 1;
+    }
+    e = e->hash_link.next;
+  }
+  return 0;
+}
+
+RamCache *
+new_RamCacheTinyLFU()
+{
+  return new RamCacheTinyLFU;
+}
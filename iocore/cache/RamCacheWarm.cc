@@ -0,0 +1,290 @@
+/** @file
+
+  Saving the RAM cache keys and warming the RAM cache after a restart.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+// Every proxy.config.cache.ram_cache.persist_interval seconds the keys in the RAM cache of each
+// stripe are written to the runtime directory, most valuable first. When the stripe comes back
+// online after a restart the fragments are read from disk again, at most
+// proxy.config.cache.ram_cache.warm_rate a second, so the RAM cache starts with the objects that
+// were hot rather than empty.
+
+#include "P_Cache.h"
+#include "ts/I_Layout.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define RAM_CACHE_KEYS_MAGIC 0x52414d4b // "RAMK"
+#define RAM_CACHE_KEYS_VERSION 1
+#define RAM_CACHE_WARM_TICKS 10    // per second
+#define RAM_CACHE_WARM_MAX_READS 8 // reads in flight per stripe
+
+struct RamCacheKeysHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t count;
+};
+
+static std::string
+ram_cache_keys_path(Vol *vol)
+{
+  char hex[CRYPTO_HEX_SIZE];
+  std::string name("ram_cache.");
+
+  name += vol->hash_id.toHexStr(hex);
+  return Layout::relative_to(RecConfigReadRuntimeDir(), name);
+}
+
+static void
+save_ram_cache_keys(Vol *vol, const std::vector<RamCacheKey> &keys)
+{
+  std::string path = ram_cache_keys_path(vol);
+  std::string tmp  = path + ".tmp";
+  RamCacheKeysHeader header{RAM_CACHE_KEYS_MAGIC, RAM_CACHE_KEYS_VERSION, keys.size()};
+  ssize_t len = keys.size() * sizeof(RamCacheKey);
+
+  int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    Warning("unable to save the RAM cache keys of stripe '%s' to '%s': %s", vol->hash_text.get(), tmp.c_str(), strerror(errno));
+    return;
+  }
+  bool ok = ::write(fd, &header, sizeof(header)) == sizeof(header) && (!len || ::write(fd, keys.data(), len) == len);
+  ok      = ::close(fd) == 0 && ok;
+  if (!ok || ::rename(tmp.c_str(), path.c_str()) < 0) {
+    Warning("unable to save the RAM cache keys of stripe '%s' to '%s': %s", vol->hash_text.get(), path.c_str(), strerror(errno));
+    ::unlink(tmp.c_str());
+    return;
+  }
+  Debug("ram_cache", "saved %zu keys of stripe '%s' to '%s'", keys.size(), vol->hash_text.get(), path.c_str());
+}
+
+static bool
+load_ram_cache_keys(Vol *vol, std::vector<RamCacheKey> &keys)
+{
+  std::string path = ram_cache_keys_path(vol);
+  RamCacheKeysHeader header;
+  struct stat st;
+
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    if (errno != ENOENT) {
+      Warning("unable to load the RAM cache keys of stripe '%s' from '%s': %s", vol->hash_text.get(), path.c_str(),
+              strerror(errno));
+    }
+    return false;
+  }
+  bool ok = ::fstat(fd, &st) == 0 && ::read(fd, &header, sizeof(header)) == sizeof(header) &&
+            header.magic == RAM_CACHE_KEYS_MAGIC && header.version == RAM_CACHE_KEYS_VERSION &&
+            static_cast<uint64_t>(st.st_size) == sizeof(header) + header.count * sizeof(RamCacheKey);
+  if (ok) {
+    ssize_t len = header.count * sizeof(RamCacheKey);
+    keys.resize(header.count);
+    ok = !len || ::read(fd, keys.data(), len) == len;
+  }
+  ::close(fd);
+  if (!ok) {
+    Warning("ignoring the RAM cache keys of stripe '%s', '%s' is damaged", vol->hash_text.get(), path.c_str());
+    keys.clear();
+  }
+  return ok;
+}
+
+// Runs on a task thread as it blocks on the stripe locks and does file I/O.
+class RamCacheSaver : public Continuation
+{
+public:
+  int mainEvent(int event, Event *e);
+
+  RamCacheSaver() : Continuation(new_ProxyMutex()) { SET_HANDLER(&RamCacheSaver::mainEvent); }
+};
+
+int
+RamCacheSaver::mainEvent(int /* event ATS_UNUSED */, Event *e)
+{
+  std::vector<RamCacheKey> keys;
+
+  for (int i = 0; i < gnvol; i++) {
+    Vol *vol = gvol[i];
+    bool save;
+
+    keys.clear();
+    MUTEX_TAKE_LOCK(vol->mutex, e->ethread);
+    // a stripe that is still warming has not seen enough traffic to replace the saved keys
+    save = vol->ram_cache && !vol->ram_cache_warming && !DISK_BAD(vol->disk);
+    if (save) {
+      vol->ram_cache->hot_keys(keys);
+    }
+    MUTEX_UNTAKE_LOCK(vol->mutex, e->ethread);
+    if (save) {
+      save_ram_cache_keys(vol, keys);
+    }
+  }
+  return EVENT_CONT;
+}
+
+// Reads the saved fragments of one stripe back into its RAM cache.
+class RamCacheWarmer : public Continuation
+{
+public:
+  Vol *vol;
+  std::vector<RamCacheKey> keys;
+  size_t next     = 0; ///< Next key to read.
+  int reads       = 0; ///< Reads in flight.
+  Event *periodic = nullptr;
+
+  int mainEvent(int event, Event *e);
+  void warm(const RamCacheKey &k);
+
+  RamCacheWarmer(Vol *avol) : Continuation(new_ProxyMutex()), vol(avol) { SET_HANDLER(&RamCacheWarmer::mainEvent); }
+};
+
+void
+RamCacheWarmer::warm(const RamCacheKey &k)
+{
+  CacheKey key        = k.key;
+  uint64_t offset     = (static_cast<uint64_t>(k.auxkey1) << 32) | k.auxkey2;
+  Dir *last_collision = nullptr;
+  Dir dir;
+
+  // the key alone is not enough, the fragment must still be where it was when it was cached
+  while (dir_probe(&key, vol, &dir, &last_collision)) {
+    if (static_cast<uint64_t>(dir_offset(&dir)) == offset) {
+      CacheVC *c = new_CacheVC(this);
+      SET_CONTINUATION_HANDLER(c, &CacheVC::ramCacheWarmRead);
+      c->vio.op    = VIO::READ;
+      c->base_stat = cache_ram_cache_warm_active_stat;
+      CACHE_INCREMENT_DYN_STAT(c->base_stat + CACHE_STAT_ACTIVE);
+      c->first_key = c->key = key;
+      c->vol                = vol;
+      c->dir = c->first_dir = dir;
+      ++reads;
+      c->handleEvent(EVENT_IMMEDIATE, nullptr);
+      return;
+    }
+  }
+  // overwritten or removed since the keys were saved
+  CACHE_INCREMENT_DYN_STAT(cache_ram_cache_warm_failure_stat);
+}
+
+int
+RamCacheWarmer::mainEvent(int event, Event * /* e ATS_UNUSED */)
+{
+  if (event != EVENT_INTERVAL) { // a read finished
+    --reads;
+    return EVENT_DONE;
+  }
+
+  if (next < keys.size()) {
+    CACHE_TRY_LOCK(lock, vol->mutex, mutex->thread_holding);
+    if (!lock.is_locked()) {
+      return EVENT_CONT;
+    }
+    if (!next) {
+      CACHE_SUM_DYN_STAT(cache_ram_cache_warm_pending_stat, keys.size());
+    }
+    if (DISK_BAD(vol->disk)) {
+      CACHE_SUM_DYN_STAT(cache_ram_cache_warm_pending_stat, -(int64_t)(keys.size() - next));
+      next = keys.size();
+    }
+    for (int n = std::max(1, cache_config_ram_cache_warm_rate / RAM_CACHE_WARM_TICKS);
+         n > 0 && reads < RAM_CACHE_WARM_MAX_READS && next < keys.size(); --n) {
+      CACHE_DECREMENT_DYN_STAT(cache_ram_cache_warm_pending_stat);
+      warm(keys[next++]);
+    }
+    if (next == keys.size()) {
+      vol->ram_cache_warming = false;
+    }
+  }
+
+  if (next == keys.size() && !reads) {
+    Note("cache stripe '%s' RAM cache warmed with %zu objects", vol->hash_text.get(), keys.size());
+    periodic->cancel();
+    delete this;
+  }
+  return EVENT_CONT;
+}
+
+int
+CacheVC::ramCacheWarmRead(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+{
+  cancel_trigger();
+  set_io_not_in_progress();
+  {
+    CACHE_TRY_LOCK(lock, vol->mutex, mutex->thread_holding);
+    if (!lock.is_locked()) {
+      VC_SCHED_LOCK_RETRY();
+    }
+    if (!buf) {
+      // handleReadDone() puts the fragment in the RAM cache
+      int ret = do_read_call(&key);
+      if (ret == EVENT_RETURN) {
+        goto Lcallreturn;
+      }
+      return ret;
+    }
+    Doc *doc = reinterpret_cast<Doc *>(buf->data());
+    if (io.ok() && doc->magic == DOC_MAGIC && (doc->key == key || doc->first_key == key)) {
+      closed = 1;
+    }
+  }
+  if (closed > 0) {
+    _action.continuation->handleEvent(CACHE_EVENT_LOOKUP, nullptr);
+  } else {
+    CACHE_INCREMENT_DYN_STAT(cache_ram_cache_warm_failure_stat);
+    _action.continuation->handleEvent(CACHE_EVENT_LOOKUP_FAILED, nullptr);
+  }
+  return free_CacheVC(this);
+Lcallreturn:
+  return handleEvent(AIO_EVENT_DONE, nullptr); // hopefully a tail call
+}
+
+void
+start_ram_cache_persist()
+{
+  if (cache_config_ram_cache_persist_interval > 0) {
+    eventProcessor.schedule_every(new RamCacheSaver, HRTIME_SECONDS(cache_config_ram_cache_persist_interval), ET_TASK);
+  }
+}
+
+void
+start_ram_cache_warm(Vol *vol)
+{
+  if (cache_config_ram_cache_persist_interval <= 0 || cache_config_ram_cache_warm_rate <= 0) {
+    return;
+  }
+
+  RamCacheWarmer *warmer = new RamCacheWarmer(vol);
+  if (!load_ram_cache_keys(vol, warmer->keys) || warmer->keys.empty()) {
+    delete warmer;
+    return;
+  }
+  Note("cache stripe '%s' warming the RAM cache with %zu objects", vol->hash_text.get(), warmer->keys.size());
+  {
+    SCOPED_MUTEX_LOCK(lock, vol->mutex, this_ethread());
+    vol->ram_cache_warming = true;
+  }
+  warmer->periodic = eventProcessor.schedule_every(warmer, HRTIME_MSECONDS(1000 / RAM_CACHE_WARM_TICKS), ET_CALL);
+}
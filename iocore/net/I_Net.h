@@ -64,6 +64,13 @@ extern int net_accept_period;
 extern int net_retry_delay;
 extern int net_throttle_delay;
 
+// Poll the net threads with io_uring instead of epoll (needs TS_USE_LINUX_IO_URING).
+extern int net_config_io_uring_enabled;
+extern int net_config_io_uring_entries;
+
+// Minimum size of a write to send it with MSG_ZEROCOPY, 0 to never.
+extern int net_config_zerocopy_threshold;
+
 #define NET_EVENT_OPEN (NET_EVENT_EVENTS_START)
 #define NET_EVENT_OPEN_FAILED (NET_EVENT_EVENTS_START + 1)
 #define NET_EVENT_ACCEPT (NET_EVENT_EVENTS_START + 2)
@@ -96,6 +96,15 @@ public:
     */
     bool f_inbound_transparent;
 
+    /** Give each event thread its own @c SO_REUSEPORT listen socket.
+        Only used when accepting on the event threads (@c accept_threads is 0),
+        the kernel then distributes the connections over the threads.
+    */
+    bool f_reuseport;
+    /// Steer connections to the listen socket of the thread on the CPU that received them.
+    /// Requires @c f_reuseport.
+    bool f_reuseport_cpu_steering;
+
     /// Default constructor.
     /// Instance is constructed with default values.
     AcceptOptions() { this->reset(); }
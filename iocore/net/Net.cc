@@ -40,6 +40,10 @@ int net_accept_period       = 10;
 int net_retry_delay         = 10;
 int net_throttle_delay      = 50; /* milliseconds */
 
+int net_config_io_uring_enabled   = 0;
+int net_config_io_uring_entries   = 4096;
+int net_config_zerocopy_threshold = 0;
+
 static inline void
 configure_net()
 {
@@ -52,6 +56,9 @@ configure_net()
   // These are not reloadable
   REC_ReadConfigInteger(net_event_period, "proxy.config.net.event_period");
   REC_ReadConfigInteger(net_accept_period, "proxy.config.net.accept_period");
+  REC_ReadConfigInteger(net_config_io_uring_enabled, "proxy.config.net.io_uring.enabled");
+  REC_ReadConfigInteger(net_config_io_uring_entries, "proxy.config.net.io_uring.entries");
+  REC_ReadConfigInteger(net_config_zerocopy_threshold, "proxy.config.net.zerocopy_threshold");
 }
 
 static inline void
@@ -72,6 +79,9 @@ register_net_stats()
     {"proxy.process.net.write_bytes", net_write_bytes_stat},
     {"proxy.process.net.fastopen_out.attempts", net_fastopen_attempts_stat},
     {"proxy.process.net.fastopen_out.successes", net_fastopen_successes_stat},
+    {"proxy.process.net.zerocopy.sends", net_zerocopy_sends_stat},
+    {"proxy.process.net.zerocopy.bytes", net_zerocopy_bytes_stat},
+    {"proxy.process.net.zerocopy.bytes_copied", net_zerocopy_bytes_copied_stat},
     {"proxy.process.socks.connections_successful", socks_connections_successful_stat},
     {"proxy.process.socks.connections_unsuccessful", socks_connections_unsuccessful_stat},
   };
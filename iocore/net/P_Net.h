@@ -57,6 +57,9 @@ enum Net_Stats {
   net_tcp_accept_stat,
   net_connections_throttled_in_stat,
   net_connections_throttled_out_stat,
+  net_zerocopy_sends_stat,
+  net_zerocopy_bytes_stat,
+  net_zerocopy_bytes_copied_stat,
   Net_Stat_Count
 };
 
@@ -92,6 +92,10 @@ struct NetAccept : public Continuation {
 
   HttpProxyPort *proxyPort = nullptr;
   NetProcessor::AcceptOptions opt;
+  /// Per thread accepts which own a SO_REUSEPORT listen socket of their own.
+  std::vector<NetAccept *> peers;
+  /// The periodic accept event of a per thread accept.
+  Event *accept_event = nullptr;
 
   virtual NetProcessor *getNetProcessor() const;
 
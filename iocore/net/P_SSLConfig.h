@@ -89,6 +89,7 @@ struct SSLConfigParams : public ConfigInfo {
 
   static int ssl_maxrecord;
   static bool ssl_allow_client_renegotiation;
+  static bool ssl_ktls_enabled;
 
   static bool ssl_ocsp_enabled;
   static int ssl_ocsp_cache_timeout;
@@ -99,6 +100,8 @@ struct SSLConfigParams : public ConfigInfo {
   static size_t session_cache_number_buckets;
   static size_t session_cache_max_bucket_size;
   static bool session_cache_skip_on_lock_contention;
+  static char *session_cache_snapshot_path;
+  static int session_cache_snapshot_interval;
   static bool sni_map_enable;
 
   // TS-3435 Wiretracing for SSL Connections
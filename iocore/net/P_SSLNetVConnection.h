@@ -320,10 +320,14 @@ public:
 private:
   ts::string_view map_tls_protocol_to_tag(const char *proto_string) const;
   bool update_rbio(bool move_to_socket);
+  void check_ktls();
+  int64_t ktls_flush(int &needs);
 
   bool sslHandShakeComplete        = false;
   bool sslClientRenegotiationAbort = false;
   bool sslSessionCacheHit          = false;
+  bool sslKtlsSend                 = false; ///< Records are encrypted by the kernel.
+  bool sslKtlsRecv                 = false; ///< Records are decrypted by the kernel.
   MIOBuffer *handShakeBuffer       = nullptr;
   IOBufferReader *handShakeHolder  = nullptr;
   IOBufferReader *handShakeReader  = nullptr;
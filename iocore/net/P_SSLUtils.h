@@ -33,6 +33,13 @@
 #endif
 #include <openssl/ssl.h>
 
+// Kernel TLS offload needs OpenSSL 3.0 built with KTLS support.
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+#define TS_HAS_KTLS 1
+#else
+#define TS_HAS_KTLS 0
+#endif
+
 struct SSLConfigParams;
 struct SSLCertLookup;
 class SSLNetVConnection;
@@ -78,6 +85,10 @@ enum SSL_Stats {
   ssl_session_cache_eviction,
   ssl_session_cache_lock_contention,
   ssl_session_cache_new_session,
+  ssl_session_cache_lru_eviction,
+  ssl_session_cache_entries,
+  ssl_session_cache_snapshot_loaded,
+  ssl_session_cache_snapshot_saved,
 
   /* error stats */
   ssl_error_want_write,
@@ -96,9 +107,17 @@ enum SSL_Stats {
   ssl_ocsp_refreshed_cert_stat,
   ssl_ocsp_refresh_cert_failure_stat,
 
+  /* kernel TLS stats */
+  ssl_ktls_send_stat,
+  ssl_ktls_recv_stat,
+  ssl_ktls_fallback_stat,
+
   ssl_cipher_stats_start = 100,
   ssl_cipher_stats_end   = 300,
 
+  ssl_ktls_cipher_stats_start = 301,
+  ssl_ktls_cipher_stats_end   = 501,
+
   Ssl_Stat_Count
 };
 
@@ -130,6 +149,9 @@ void SSLPostConfigInitialize();
 // Initialize SSL statistics.
 void SSLInitializeStatistics();
 
+// Count a connection whose records are encrypted by the kernel, by cipher.
+void SSLIncrementKtlsCipherStat(const SSL *ssl);
+
 // Release SSL_CTX and the associated data. This works for both
 // client and server contexts and gracefully accepts nullptr.
 void SSLReleaseContext(SSL_CTX *ctx);
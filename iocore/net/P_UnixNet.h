@@ -83,6 +83,9 @@ struct EventIO {
 #endif
   EventLoop event_loop = nullptr;
   int type             = 0;
+#if TS_USE_EPOLL && TS_USE_LINUX_IO_URING
+  uint64_t uring_id = 0; ///< io_uring poll request user data, see PollDescriptor.
+#endif
   union {
     Continuation *c;
     UnixNetVConnection *vc;
@@ -112,6 +115,7 @@ struct EventIO {
 #include "P_DNSConnection.h"
 #include "P_UnixUDPConnection.h"
 #include "P_UnixPollDescriptor.h"
+#include "P_UnixZeroCopy.h"
 #include <limits>
 
 class UnixNetVConnection;
@@ -242,6 +246,7 @@ public:
   uint32_t keep_alive_queue_size = 0;
   Que(UnixNetVConnection, active_queue_link) active_queue;
   uint32_t active_queue_size = 0;
+  Que(ZeroCopyTracker, link) zerocopy_linger_list;
 
   /// configuration settings for managing the active and keep-alive queues
   struct Config {
@@ -347,6 +352,17 @@ public:
    */
   void free_netvc(UnixNetVConnection *netvc);
 
+  /**
+    Keep the socket of a closed connection until the kernel is done with its MSG_ZEROCOPY sends.
+    The socket is shut down right away, it is closed and @a zc deleted once the sends complete.
+
+    @param zc The buffers of the sends in flight, ownership passes to the NetHandler.
+    @param fd The socket.
+   */
+  void zerocopy_linger(ZeroCopyTracker *zc, int fd);
+  /// Release the lingering zero copy sockets which are done or timed out.
+  void manage_zerocopy_linger(ink_hrtime now);
+
   NetHandler();
 
 private:
@@ -579,6 +595,14 @@ EventIO::start(EventLoop l, int afd, Continuation *c, int e)
   fd         = afd;
   event_loop = l;
 #if TS_USE_EPOLL
+#if TS_USE_LINUX_IO_URING
+  if (event_loop->uring) {
+#ifndef USE_EDGE_TRIGGER
+    events = e;
+#endif
+    return event_loop->uring_add(this, fd, e);
+  }
+#endif
   struct epoll_event ev;
   memset(&ev, 0, sizeof(ev));
   ev.events   = e;
@@ -612,6 +636,15 @@ EventIO::modify(int e)
 {
   ink_assert(event_loop);
 #if TS_USE_EPOLL && !defined(USE_EDGE_TRIGGER)
+#if TS_USE_LINUX_IO_URING
+  if (event_loop->uring) {
+    EventLoop l    = event_loop;
+    int new_events = e < 0 ? (events & ~(-e)) : (events | e);
+    l->uring_remove(this);
+    events = new_events;
+    return new_events ? l->uring_add(this, fd, new_events) : 0;
+  }
+#endif
   struct epoll_event ev;
   memset(&ev, 0, sizeof(ev));
   int new_events = events, old_events = events;
@@ -733,6 +766,13 @@ EventIO::stop()
   if (event_loop) {
     int retval = 0;
 #if TS_USE_EPOLL
+#if TS_USE_LINUX_IO_URING
+    if (event_loop->uring) {
+      retval     = event_loop->uring_remove(this);
+      event_loop = nullptr;
+      return retval;
+    }
+#endif
     struct epoll_event ev;
     memset(&ev, 0, sizeof(struct epoll_event));
     ev.events = EPOLLIN | EPOLLOUT | EPOLLET;
@@ -40,6 +40,7 @@
 class UnixNetVConnection;
 class NetHandler;
 struct PollDescriptor;
+class ZeroCopyTracker;
 
 TS_INLINE void
 NetVCOptions::reset()
@@ -259,6 +260,8 @@ public:
   OOB_callback *oob_ptr;
   bool from_accept_thread;
   NetAccept *accept_object;
+  /// MSG_ZEROCOPY sends in flight, @c nullptr until zero copy is first tried.
+  ZeroCopyTracker *zerocopy;
 
   // es - origin_trace associated connections
   bool origin_trace;
@@ -277,6 +280,8 @@ public:
   virtual int populate(Connection &con, Continuation *c, void *arg);
   virtual void clear();
   virtual void free(EThread *t);
+  /// Release the MSG_ZEROCOPY state before the socket is closed.
+  void release_zerocopy(EThread *t);
 
   ink_hrtime get_inactivity_timeout() override;
   ink_hrtime get_active_timeout() override;
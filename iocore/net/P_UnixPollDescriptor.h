@@ -31,6 +31,11 @@
 
 #include "ts/ink_platform.h"
 
+#if TS_USE_EPOLL && TS_USE_LINUX_IO_URING
+#include <liburing.h>
+#include <vector>
+#endif
+
 #if TS_USE_KQUEUE
 #include <sys/event.h>
 #define INK_EVP_IN 0x001
@@ -44,6 +49,9 @@
 
 typedef struct pollfd Pollfd;
 
+struct EventIO;
+class EThread;
+
 struct PollDescriptor {
   int result; // result of poll
 #if TS_USE_EPOLL
@@ -52,6 +60,59 @@ struct PollDescriptor {
   Pollfd pfd[POLL_DESCRIPTOR_SIZE];
   struct epoll_event ePoll_Triggered_Events[POLL_DESCRIPTOR_SIZE];
 #endif
+#if TS_USE_EPOLL && TS_USE_LINUX_IO_URING
+  /*
+    Optional io_uring poller used instead of epoll_wait. Each EventIO gets a
+    multishot poll request; additions and removals are queued and submitted
+    together with the wait, so a loop iteration makes one system call.
+    Completions are translated into ePoll_Triggered_Events so the consumers
+    of get_ev_events / get_ev_data are unchanged.
+
+    The user data of a poll request is the slot index and generation of the
+    EventIO, stale completions for an EventIO that has been stopped (and
+    possibly freed) are dropped by checking the generation.
+
+    The ring and the slots belong to the thread that started the ring. An
+    EventIO started or stopped from another thread (accept setup, stopping
+    accepts, migrating a connection) is put on uring_changes instead, which
+    the owning thread applies before its next submission.
+  */
+  struct UringSlot {
+    EventIO *eio    = nullptr;
+    uint32_t gen    = 0;
+    uint32_t events = 0;
+  };
+  struct UringChange {
+    EventIO *eio;
+    uint64_t id; ///< uring_id of the EventIO, for a removal.
+    int fd;
+    int events;
+    bool add;
+  };
+  struct io_uring *uring = nullptr; ///< Non-null when polling through io_uring.
+  struct io_uring_cqe **uring_cqes = nullptr;
+  std::vector<UringSlot> uring_slots;
+  std::vector<uint32_t> uring_free_slots;
+  EThread *uring_thread = nullptr; ///< Thread owning the ring.
+  ink_mutex uring_changes_lock;
+  std::vector<UringChange> uring_changes; ///< Additions and removals from other threads.
+
+  bool uring_start(unsigned entries);
+  int uring_add(EventIO *eio, int fd, int events);
+  int uring_remove(EventIO *eio);
+  void uring_poll(int timeout_ms);
+
+  ~PollDescriptor();
+
+private:
+  struct io_uring_sqe *uring_get_sqe();
+  void uring_arm(uint32_t slot, int fd);
+  void uring_add_slot(EventIO *eio, int fd, int events);
+  int uring_remove_slot(EventIO *eio, uint64_t id);
+  void uring_apply_changes();
+
+public:
+#endif
 #if TS_USE_KQUEUE
   int kqueue_fd;
 #endif
@@ -0,0 +1,83 @@
+/** @file
+
+  Completion tracking for MSG_ZEROCOPY sends.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+#include "ts/ink_platform.h"
+#include "ts/ink_hrtime.h"
+#include "ts/List.h"
+#include "I_IOBuffer.h"
+
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+#define TS_HAS_MSG_ZEROCOPY 1
+#else
+#define TS_HAS_MSG_ZEROCOPY 0
+#endif
+
+/** Buffers of the sends done with @c MSG_ZEROCOPY on a socket.
+
+    The kernel transmits straight from the memory of the IOBufferBlocks, so a
+    reference to them is held until the kernel reports on the socket error
+    queue that it is done. The kernel numbers the zero copy sends of a socket
+    starting at 0 and reports completions as ranges of those numbers.
+ */
+class ZeroCopyTracker
+{
+public:
+  /** Record a zero copy send.
+
+      @param blocks The blocks the data of @a iov lives in.
+      @param iov The vector that was sent.
+      @param niov Number of entries in @a blocks and @a iov.
+      @param nbytes The number of bytes the send wrote.
+   */
+  void sent(IOBufferBlock *const *blocks, const IOVec *iov, unsigned niov, int64_t nbytes);
+
+  /** Read the completions from the error queue of @a fd and release the blocks they cover.
+
+      @return The number of sends still in flight.
+   */
+  int reap(int fd);
+
+  /// Zero copy should not be used for the socket, because it can't be turned on or the kernel copies anyway.
+  bool disabled = false;
+
+  /// The socket, once it is no longer owned by a connection but still has sends in flight.
+  int fd = -1;
+  /// When to give up waiting for the sends in flight.
+  ink_hrtime linger_until = 0;
+  LINK(ZeroCopyTracker, link);
+
+private:
+  void complete(uint32_t lo, uint32_t hi, bool copied);
+
+  struct Pending {
+    uint32_t seq;
+    int64_t bytes;
+    Ptr<IOBufferBlock> block;
+  };
+  std::deque<Pending> pending;
+  uint32_t next_seq  = 0; ///< Number the kernel will give the next send.
+  uint32_t in_flight = 0; ///< Sends not yet completed.
+};
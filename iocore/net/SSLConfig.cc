@@ -46,6 +46,7 @@ int SSLCertificateConfig::configid                          = 0;
 int SSLTicketKeyConfig::configid                            = 0;
 int SSLConfigParams::ssl_maxrecord                          = 0;
 bool SSLConfigParams::ssl_allow_client_renegotiation        = false;
+bool SSLConfigParams::ssl_ktls_enabled                      = false;
 bool SSLConfigParams::ssl_ocsp_enabled                      = false;
 int SSLConfigParams::ssl_ocsp_cache_timeout                 = 3600;
 int SSLConfigParams::ssl_ocsp_request_timeout               = 10;
@@ -54,6 +55,8 @@ int SSLConfigParams::ssl_handshake_timeout_in               = 0;
 size_t SSLConfigParams::session_cache_number_buckets        = 1024;
 bool SSLConfigParams::session_cache_skip_on_lock_contention = false;
 size_t SSLConfigParams::session_cache_max_bucket_size       = 100;
+char *SSLConfigParams::session_cache_snapshot_path          = nullptr;
+int SSLConfigParams::session_cache_snapshot_interval        = 300;
 init_ssl_ctx_func SSLConfigParams::init_ssl_ctx_cb          = nullptr;
 load_ssl_file_func SSLConfigParams::load_ssl_file_cb        = nullptr;
 bool SSLConfigParams::sni_map_enable                        = false;
@@ -258,6 +261,19 @@ SSLConfigParams::initialize()
   ssl_client_ctx_options |= SSL_OP_NO_SESSION_RESUMPTION_ON_RENEGOTIATION;
 #endif
 
+  // Let OpenSSL hand the record encryption of inbound connections to the kernel.
+  REC_ReadConfigInt32(ssl_ktls_enabled, "proxy.config.ssl.ktls.enabled");
+#if TS_HAS_KTLS
+  if (ssl_ktls_enabled) {
+    ssl_ctx_options |= SSL_OP_ENABLE_KTLS;
+  }
+#else
+  if (ssl_ktls_enabled) {
+    Warning("proxy.config.ssl.ktls.enabled is set, but the TLS library does not support kernel TLS");
+    ssl_ktls_enabled = false;
+  }
+#endif
+
   REC_ReadConfigStringAlloc(serverCertChainFilename, "proxy.config.ssl.server.cert_chain.filename");
   REC_ReadConfigStringAlloc(serverCertRelativePath, "proxy.config.ssl.server.cert.path");
   set_paths_helper(serverCertRelativePath, nullptr, &serverCertPathOnly, nullptr);
@@ -288,6 +304,17 @@ SSLConfigParams::initialize()
   SSLConfigParams::session_cache_skip_on_lock_contention = ssl_session_cache_skip_on_contention;
   SSLConfigParams::session_cache_number_buckets          = ssl_session_cache_num_buckets;
 
+  char *ssl_session_cache_snapshot_filename = nullptr;
+  REC_ReadConfigStringAlloc(ssl_session_cache_snapshot_filename, "proxy.config.ssl.session_cache.snapshot.filename");
+  REC_ReadConfigInteger(SSLConfigParams::session_cache_snapshot_interval, "proxy.config.ssl.session_cache.snapshot.interval");
+  ats_free(SSLConfigParams::session_cache_snapshot_path);
+  SSLConfigParams::session_cache_snapshot_path = nullptr;
+  if (ssl_session_cache_snapshot_filename && *ssl_session_cache_snapshot_filename) {
+    SSLConfigParams::session_cache_snapshot_path =
+      ats_stringdup(Layout::relative_to(Layout::get()->runtimedir, ssl_session_cache_snapshot_filename));
+  }
+  ats_free(ssl_session_cache_snapshot_filename);
+
   if (ssl_session_cache == SSL_SESSION_CACHE_MODE_SERVER_ATS_IMPL) {
     session_cache = new SSLSessionCache();
   }
@@ -27,6 +27,7 @@
 #include "P_SSLUtils.h"
 #include "P_OCSPStapling.h"
 #include "P_SSLSNI.h"
+#include "SSLSessionCache.h"
 
 //
 // Global Data
@@ -49,6 +50,20 @@ struct OCSPContinuation : public Continuation {
 };
 #endif /* HAVE_OPENSSL_OCSP_STAPLING */
 
+struct SSLSessionSnapshotContinuation : public Continuation {
+  int
+  mainEvent(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
+  {
+    if (session_cache) {
+      session_cache->saveSnapshot(SSLConfigParams::session_cache_snapshot_path);
+    }
+
+    return EVENT_CONT;
+  }
+
+  SSLSessionSnapshotContinuation() : Continuation(new_ProxyMutex()) { SET_HANDLER(&SSLSessionSnapshotContinuation::mainEvent); }
+};
+
 void
 SSLNetProcessor::cleanup()
 {
@@ -81,6 +96,13 @@ SSLNetProcessor::start(int, size_t stacksize)
   }
 #endif /* HAVE_OPENSSL_OCSP_STAPLING */
 
+  // Restore the sessions saved by the previous run, then keep the snapshot up to date.
+  if (session_cache && SSLConfigParams::session_cache_snapshot_path) {
+    session_cache->loadSnapshot(SSLConfigParams::session_cache_snapshot_path);
+    eventProcessor.schedule_every(new SSLSessionSnapshotContinuation(),
+                                  HRTIME_SECONDS(SSLConfigParams::session_cache_snapshot_interval), ET_TASK);
+  }
+
   // We have removed the difference between ET_SSL threads and ET_NET threads,
   // So just keep on chugging
   return 0;
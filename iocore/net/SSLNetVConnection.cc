@@ -146,6 +146,18 @@ private:
 // Private
 //
 
+// OpenSSL can only turn on kernel TLS through a socket BIO, the fd BIO doesn't support it.
+static BIO *
+new_socket_bio(int fd)
+{
+#if TS_HAS_KTLS
+  if (SSLConfigParams::ssl_ktls_enabled) {
+    return BIO_new_socket(fd, BIO_NOCLOSE);
+  }
+#endif
+  return BIO_new_fd(fd, BIO_NOCLOSE);
+}
+
 static SSL *
 make_ssl_connection(SSL_CTX *ctx, SSLNetVConnection *netvc)
 {
@@ -167,7 +179,7 @@ make_ssl_connection(SSL_CTX *ctx, SSLNetVConnection *netvc)
     } else {
       netvc->initialize_handshake_buffers();
       BIO *rbio = BIO_new(BIO_s_mem());
-      BIO *wbio = BIO_new_fd(netvc->get_socket(), BIO_NOCLOSE);
+      BIO *wbio = new_socket_bio(netvc->get_socket());
       BIO_set_mem_eof_return(wbio, -1);
       SSL_set_bio(ssl, rbio, wbio);
     }
@@ -435,7 +447,7 @@ SSLNetVConnection::update_rbio(bool move_to_socket)
       retval = true;
       // Handshake buffer is empty but we have read something, move to the socket rbio
     } else if (move_to_socket && this->handShakeHolder->is_read_avail_more_than(0)) {
-      BIO *rbio = BIO_new_fd(this->get_socket(), BIO_NOCLOSE);
+      BIO *rbio = new_socket_bio(this->get_socket());
       BIO_set_mem_eof_return(rbio, -1);
       SSL_set0_rbio(this->ssl, rbio);
       free_handshake_buffers();
@@ -695,6 +707,19 @@ SSLNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &buf
     return this->super::load_buffer_and_write(towrite, buf, total_written, needs);
   }
 
+  // With kernel TLS the kernel builds the records, the plain socket write path does the rest.
+  if (this->sslKtlsSend) {
+    int64_t r = this->ktls_flush(needs);
+    if (r == 0) {
+      r = this->super::load_buffer_and_write(towrite, buf, total_written, needs);
+    }
+    if (total_written > 0) {
+      sslLastWriteTime = now;
+      sslTotalBytesSent += total_written;
+    }
+    return r;
+  }
+
   bool trace = getSSLTrace();
 
   do {
@@ -872,6 +897,8 @@ SSLNetVConnection::clear()
   sslTotalBytesSent           = 0;
   sslClientRenegotiationAbort = false;
   sslSessionCacheHit          = false;
+  sslKtlsSend                 = false;
+  sslKtlsRecv                 = false;
 
   curHook              = nullptr;
   hookOpRequested      = SSL_HOOK_OP_DEFAULT;
@@ -883,6 +910,79 @@ SSLNetVConnection::clear()
 
   super::clear();
 }
+/**
+  OpenSSL still writes the records it makes on its own, session tickets and
+  key updates, through the kTLS socket BIO. Those are only sent from inside
+  SSL_write, so give it one with no data before data is written past it.
+
+  @return 0 when nothing is pending any more, else the error for the write.
+ */
+int64_t
+SSLNetVConnection::ktls_flush(int &needs)
+{
+#if TS_HAS_KTLS
+  if (!SSL_want_write(ssl) && SSL_get_key_update_type(ssl) == SSL_KEY_UPDATE_NONE) {
+    return 0;
+  }
+
+  size_t written = 0;
+  ERR_clear_error();
+  int ret = SSL_write_ex(ssl, "", 0, &written);
+  if (ret > 0) {
+    return 0;
+  }
+
+  switch (SSL_get_error(ssl, ret)) {
+  case SSL_ERROR_WANT_WRITE:
+    SSL_INCREMENT_DYN_STAT(ssl_error_want_write);
+    needs |= EVENTIO_WRITE;
+    return -EAGAIN;
+  case SSL_ERROR_WANT_READ:
+    SSL_INCREMENT_DYN_STAT(ssl_error_want_read);
+    needs |= EVENTIO_READ;
+    return -EAGAIN;
+  case SSL_ERROR_SYSCALL:
+    SSL_INCREMENT_DYN_STAT(ssl_error_syscall);
+    return errno ? -errno : -EPIPE;
+  default:
+    SSL_CLR_ERR_INCR_DYN_STAT(this, ssl_error_ssl, "SSL_write-SSL_ERROR_SSL errno=%d", errno);
+    return -EPIPE;
+  }
+#else
+  (void)needs;
+  return 0;
+#endif
+}
+
+// Find out whether OpenSSL moved the record layer into the kernel when the handshake completed.
+void
+SSLNetVConnection::check_ktls()
+{
+#if TS_HAS_KTLS
+  sslKtlsSend = BIO_get_ktls_send(SSL_get_wbio(ssl));
+  sslKtlsRecv = BIO_get_ktls_recv(SSL_get_rbio(ssl));
+  Debug("ssl", "kernel TLS send=%d recv=%d cipher=%s", sslKtlsSend, sslKtlsRecv, SSL_get_cipher_name(ssl));
+
+  if (!sslKtlsSend) {
+    // Unsupported cipher or the kernel refused the keys, OpenSSL keeps doing the encryption.
+    SSL_INCREMENT_DYN_STAT(ssl_ktls_fallback_stat);
+    return;
+  }
+
+  SSL_INCREMENT_DYN_STAT(ssl_ktls_send_stat);
+  if (sslKtlsRecv) {
+    SSL_INCREMENT_DYN_STAT(ssl_ktls_recv_stat);
+  }
+  SSLIncrementKtlsCipherStat(ssl);
+
+  // The TLS socket layer rejects MSG_ZEROCOPY, don't let the plain write path try it.
+  if (net_config_zerocopy_threshold > 0 && zerocopy == nullptr) {
+    zerocopy           = new ZeroCopyTracker;
+    zerocopy->disabled = true;
+  }
+#endif
+}
+
 void
 SSLNetVConnection::free(EThread *t)
 {
@@ -894,6 +994,7 @@ SSLNetVConnection::free(EThread *t)
   if (con.fd != NO_FD) {
     NET_SUM_GLOBAL_DYN_STAT(net_connections_currently_open_stat, -1);
   }
+  release_zerocopy(t);
   con.close();
 
   clear();
@@ -1169,6 +1270,9 @@ SSLNetVConnection::sslServerHandShakeEvent(int &err)
     }
 
     sslHandShakeComplete = true;
+    if (SSLConfigParams::ssl_ktls_enabled) {
+      check_ktls();
+    }
 
     TraceIn(trace, get_remote_addr(), get_remote_port(), "SSL server handshake completed successfully");
     // do we want to include cert info in trace?
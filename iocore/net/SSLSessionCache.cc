@@ -113,6 +113,146 @@ SSLSessionCache::insertSession(const SSLSessionID &sid, SSL_SESSION *sess)
   bucket->insertSession(sid, sess);
 }
 
+/*
+  The snapshot is a "TSSC" magic and a version followed by the sessions of every bucket, see
+  SSLSessionBucket::appendSnapshot. It is only meant to be read back by the same host, so it is
+  written in host byte order.
+ */
+static const char SSL_SESSION_SNAPSHOT_MAGIC[4]     = {'T', 'S', 'S', 'C'};
+static const uint32_t SSL_SESSION_SNAPSHOT_VERSION = 1;
+
+int
+SSLSessionCache::saveSnapshot(const char *path) const
+{
+  std::string snapshot;
+  std::string tmp_path(path);
+  int count = 0;
+
+  snapshot.append(SSL_SESSION_SNAPSHOT_MAGIC, sizeof(SSL_SESSION_SNAPSHOT_MAGIC));
+  snapshot.append(reinterpret_cast<const char *>(&SSL_SESSION_SNAPSHOT_VERSION), sizeof(SSL_SESSION_SNAPSHOT_VERSION));
+  for (size_t i = 0; i < nbuckets; ++i) {
+    count += session_bucket[i].appendSnapshot(snapshot);
+  }
+
+  // The session keys are in there, keep the file private.
+  tmp_path += ".tmp";
+  ats_scoped_fd fd(::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600));
+  if (fd < 0) {
+    Warning("unable to write SSL session cache snapshot '%s': %s", tmp_path.c_str(), strerror(errno));
+    return -1;
+  }
+  if (::write(fd, snapshot.data(), snapshot.size()) != static_cast<ssize_t>(snapshot.size()) ||
+      ::rename(tmp_path.c_str(), path) != 0) {
+    Warning("unable to write SSL session cache snapshot '%s': %s", path, strerror(errno));
+    ::unlink(tmp_path.c_str());
+    return -1;
+  }
+
+  Debug("ssl.session_cache", "saved %d sessions to snapshot '%s'", count, path);
+  if (ssl_rsb) {
+    SSL_INCREMENT_DYN_STAT_EX(ssl_session_cache_snapshot_saved, count);
+  }
+  return count;
+}
+
+int
+SSLSessionCache::loadSnapshot(const char *path)
+{
+  struct stat st;
+  ats_scoped_fd fd(::open(path, O_RDONLY | O_CLOEXEC));
+
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    Debug("ssl.session_cache", "no SSL session cache snapshot at '%s': %s", path, strerror(errno));
+    return 0;
+  }
+
+  std::string snapshot(st.st_size, '\0');
+  if (::read(fd, &snapshot[0], snapshot.size()) != static_cast<ssize_t>(snapshot.size())) {
+    Warning("unable to read SSL session cache snapshot '%s': %s", path, strerror(errno));
+    return -1;
+  }
+
+  const char *cur = snapshot.data();
+  const char *end = cur + snapshot.size();
+  uint32_t version;
+
+  if (snapshot.size() < sizeof(SSL_SESSION_SNAPSHOT_MAGIC) + sizeof(version) ||
+      memcmp(cur, SSL_SESSION_SNAPSHOT_MAGIC, sizeof(SSL_SESSION_SNAPSHOT_MAGIC)) != 0) {
+    Warning("ignoring SSL session cache snapshot '%s', bad header", path);
+    return -1;
+  }
+  cur += sizeof(SSL_SESSION_SNAPSHOT_MAGIC);
+  memcpy(&version, cur, sizeof(version));
+  cur += sizeof(version);
+  if (version != SSL_SESSION_SNAPSHOT_VERSION) {
+    Warning("ignoring SSL session cache snapshot '%s', version %u is not %u", path, version, SSL_SESSION_SNAPSHOT_VERSION);
+    return -1;
+  }
+
+  int count  = 0;
+  time_t now = time(nullptr);
+  while (end - cur >= static_cast<ptrdiff_t>(2 * sizeof(uint16_t))) {
+    uint16_t lens[2];
+    memcpy(lens, cur, sizeof(lens));
+    cur += sizeof(lens);
+    if (lens[0] > sizeof(SSLSessionID::bytes) || end - cur < lens[0] + lens[1]) {
+      Warning("SSL session cache snapshot '%s' is truncated, loaded %d sessions", path, count);
+      break;
+    }
+
+    SSLSessionID sid(reinterpret_cast<const unsigned char *>(cur), lens[0]);
+    const unsigned char *loc = reinterpret_cast<const unsigned char *>(cur + lens[0]);
+    SSL_SESSION *sess        = d2i_SSL_SESSION(nullptr, &loc, lens[1]);
+    cur += lens[0] + lens[1];
+
+    // Sessions that expired while we were down are dropped.
+    if (sess && SSL_SESSION_get_time(sess) + SSL_SESSION_get_timeout(sess) > now) {
+      insertSession(sid, sess);
+      ++count;
+    }
+    if (sess) {
+      SSL_SESSION_free(sess);
+    }
+  }
+
+  Note("loaded %d SSL sessions from snapshot '%s'", count, path);
+  if (ssl_rsb) {
+    SSL_INCREMENT_DYN_STAT_EX(ssl_session_cache_snapshot_loaded, count);
+  }
+  return count;
+}
+
+// Take the bucket lock shared, returns false if the lookup should be skipped because of contention.
+bool
+SSLSessionBucket::readLock()
+{
+  if (ink_rwlock_tryrdlock(&lock) != 0) {
+    if (ssl_rsb) {
+      SSL_INCREMENT_DYN_STAT(ssl_session_cache_lock_contention);
+    }
+    if (SSLConfigParams::session_cache_skip_on_lock_contention) {
+      return false;
+    }
+    ink_rwlock_rdlock(&lock);
+  }
+  return true;
+}
+
+bool
+SSLSessionBucket::writeLock()
+{
+  if (ink_rwlock_trywrlock(&lock) != 0) {
+    if (ssl_rsb) {
+      SSL_INCREMENT_DYN_STAT(ssl_session_cache_lock_contention);
+    }
+    if (SSLConfigParams::session_cache_skip_on_lock_contention) {
+      return false;
+    }
+    ink_rwlock_wrlock(&lock);
+  }
+  return true;
+}
+
 void
 SSLSessionBucket::insertSession(const SSLSessionID &id, SSL_SESSION *sess)
 {
@@ -129,78 +269,64 @@ SSLSessionBucket::insertSession(const SSLSessionID &id, SSL_SESSION *sess)
     Debug("ssl.session_cache", "Inserting session '%s' to bucket %p.", buf, this);
   }
 
-  MUTEX_TRY_LOCK(lock, mutex, this_ethread());
-  if (!lock.is_locked()) {
-    if (ssl_rsb) {
-      SSL_INCREMENT_DYN_STAT(ssl_session_cache_lock_contention);
-    }
-    if (SSLConfigParams::session_cache_skip_on_lock_contention) {
-      return;
-    }
-    lock.acquire(this_ethread());
+  // Serialize the session before taking the lock.
+  Ptr<IOBufferData> buf;
+  buf = new_IOBufferData(buffer_size_to_index(len, MAX_BUFFER_SIZE_INDEX), MEMALIGNED);
+  ink_release_assert(static_cast<size_t>(buf->block_size()) >= len);
+  unsigned char *loc = reinterpret_cast<unsigned char *>(buf->data());
+  i2d_SSL_SESSION(sess, &loc);
+
+  if (!writeLock()) {
+    return;
   }
 
   PRINT_BUCKET("insertSession before")
-  if (queue.size >= static_cast<int>(SSLConfigParams::session_cache_max_bucket_size)) {
-    removeOldestSession();
-  }
 
   // Don't insert if it is already there
-  SSLSession *node = queue.tail;
-  while (node) {
-    if (node->session_id == id) {
-      return;
-    }
-    node = node->link.prev;
+  if (bucket_map.find(id) != bucket_map.end()) {
+    ink_rwlock_unlock(&lock);
+    return;
   }
 
-  Ptr<IOBufferData> buf;
-  buf = new_IOBufferData(buffer_size_to_index(len, MAX_BUFFER_SIZE_INDEX), MEMALIGNED);
-  ink_release_assert(static_cast<size_t>(buf->block_size()) >= len);
-  unsigned char *loc = reinterpret_cast<unsigned char *>(buf->data());
-  i2d_SSL_SESSION(sess, &loc);
+  if (queue.size >= static_cast<int>(SSLConfigParams::session_cache_max_bucket_size)) {
+    removeOldestSession();
+  }
 
-  ats_scoped_obj<SSLSession> ssl_session(new SSLSession(id, buf, len));
+  SSLSession *ssl_session = new SSLSession(id, buf, len);
 
   /* do the actual insert */
-  queue.enqueue(ssl_session.release());
+  queue.enqueue(ssl_session);
+  bucket_map.insert(std::make_pair(ssl_session->session_id, ssl_session));
+  if (ssl_rsb) {
+    SSL_INCREMENT_DYN_STAT(ssl_session_cache_entries);
+  }
 
   PRINT_BUCKET("insertSession after")
+  ink_rwlock_unlock(&lock);
 }
 
 int
 SSLSessionBucket::getSessionBuffer(const SSLSessionID &id, char *buffer, int &len)
 {
   int true_len = 0;
-  MUTEX_TRY_LOCK(lock, mutex, this_ethread());
-  if (!lock.is_locked()) {
-    if (ssl_rsb) {
-      SSL_INCREMENT_DYN_STAT(ssl_session_cache_lock_contention);
-    }
-    if (SSLConfigParams::session_cache_skip_on_lock_contention) {
-      return true_len;
-    }
 
-    lock.acquire(this_ethread());
+  if (!readLock()) {
+    return true_len;
   }
 
-  // We work backwards because that's the most likely place we'll find our session...
-  SSLSession *node = queue.tail;
-  while (node) {
-    if (node->session_id == id) {
-      true_len = node->len_asn1_data;
-      if (buffer) {
-        const unsigned char *loc = reinterpret_cast<const unsigned char *>(node->asn1_data->data());
-        if (true_len < len) {
-          len = true_len;
-        }
-        memcpy(buffer, loc, len);
-        return true_len;
-      }
+  auto entry = bucket_map.find(id);
+  if (entry != bucket_map.end() && buffer) {
+    SSLSession *node         = entry->second;
+    const unsigned char *loc = reinterpret_cast<const unsigned char *>(node->asn1_data->data());
+    true_len                 = node->len_asn1_data;
+    if (true_len < len) {
+      len = true_len;
     }
-    node = node->link.prev;
+    memcpy(buffer, loc, len);
   }
-  return 0;
+
+  ink_rwlock_unlock(&lock);
+  return true_len;
 }
 
 bool
@@ -214,36 +340,47 @@ SSLSessionBucket::getSession(const SSLSessionID &id, SSL_SESSION **sess)
 
   Debug("ssl.session_cache", "Looking for session with id '%s' in bucket %p", buf, this);
 
-  MUTEX_TRY_LOCK(lock, mutex, this_ethread());
-  if (!lock.is_locked()) {
-    if (ssl_rsb) {
-      SSL_INCREMENT_DYN_STAT(ssl_session_cache_lock_contention);
-    }
-    if (SSLConfigParams::session_cache_skip_on_lock_contention) {
-      return false;
-    }
-
-    lock.acquire(this_ethread());
+  if (!readLock()) {
+    return false;
   }
 
   PRINT_BUCKET("getSession")
 
-  // We work backwards because that's the most likely place we'll find our session...
-  SSLSession *node = queue.tail;
-  while (node) {
-    if (node->session_id == id) {
-      const unsigned char *loc = reinterpret_cast<const unsigned char *>(node->asn1_data->data());
-      *sess                    = d2i_SSL_SESSION(nullptr, &loc, node->len_asn1_data);
+  auto entry = bucket_map.find(id);
+  if (entry != bucket_map.end()) {
+    SSLSession *node         = entry->second;
+    const unsigned char *loc = reinterpret_cast<const unsigned char *>(node->asn1_data->data());
+    *sess                    = d2i_SSL_SESSION(nullptr, &loc, node->len_asn1_data);
+    node->referenced         = true;
 
-      return true;
-    }
-    node = node->link.prev;
+    ink_rwlock_unlock(&lock);
+    return true;
   }
 
+  ink_rwlock_unlock(&lock);
   Debug("ssl.session_cache", "Session with id '%s' not found in bucket %p.", buf, this);
   return false;
 }
 
+/* Serialize the bucket as (id length, data length, id, data) records, returns the number of sessions. */
+int
+SSLSessionBucket::appendSnapshot(std::string &snapshot)
+{
+  int count = 0;
+
+  ink_rwlock_rdlock(&lock);
+  for (SSLSession *node = queue.head; node; node = node->link.next) {
+    uint16_t lens[2] = {static_cast<uint16_t>(node->session_id.len), static_cast<uint16_t>(node->len_asn1_data)};
+    snapshot.append(reinterpret_cast<const char *>(lens), sizeof(lens));
+    snapshot.append(node->session_id.bytes, node->session_id.len);
+    snapshot.append(node->asn1_data->data(), node->len_asn1_data);
+    ++count;
+  }
+  ink_rwlock_unlock(&lock);
+
+  return count;
+}
+
 void inline SSLSessionBucket::print(const char *ref_str) const
 {
   /* NOTE: This method assumes you're already holding the bucket lock */
@@ -266,10 +403,17 @@ void inline SSLSessionBucket::print(const char *ref_str) const
 
 void inline SSLSessionBucket::removeOldestSession()
 {
-  // Caller must hold the bucket lock.
-  ink_assert(this_ethread() == mutex->thread_holding);
-
+  // Caller must hold the bucket write lock.
   PRINT_BUCKET("removeOldestSession before")
+
+  // Give the sessions that were looked up a second chance, every session is visited at most once.
+  int unreferenced = queue.size;
+  while (queue.head && queue.head->referenced && unreferenced-- > 0) {
+    SSLSession *node = queue.pop();
+    node->referenced = false;
+    queue.enqueue(node);
+  }
+
   while (queue.head && queue.size >= static_cast<int>(SSLConfigParams::session_cache_max_bucket_size)) {
     SSLSession *old_head = queue.pop();
     if (is_debug_tag_set("ssl.session_cache")) {
@@ -278,7 +422,12 @@ void inline SSLSessionBucket::removeOldestSession()
       Debug("ssl.session_cache", "Removing session '%s' from bucket %p because the bucket has size %d and max %zd", buf, this,
             (queue.size + 1), SSLConfigParams::session_cache_max_bucket_size);
     }
+    bucket_map.erase(old_head->session_id);
     delete old_head;
+    if (ssl_rsb) {
+      SSL_INCREMENT_DYN_STAT(ssl_session_cache_lru_eviction);
+      SSL_DECREMENT_DYN_STAT(ssl_session_cache_entries);
+    }
   }
   PRINT_BUCKET("removeOldestSession after")
 }
@@ -286,19 +435,30 @@ void inline SSLSessionBucket::removeOldestSession()
 void
 SSLSessionBucket::removeSession(const SSLSessionID &id)
 {
-  SCOPED_MUTEX_LOCK(lock, mutex, this_ethread()); // We can't bail on contention here because this session MUST be removed.
-  SSLSession *node = queue.head;
-  while (node) {
-    if (node->session_id == id) {
-      queue.remove(node);
-      delete node;
-      return;
+  ink_rwlock_wrlock(&lock); // We can't bail on contention here because this session MUST be removed.
+  auto entry = bucket_map.find(id);
+  if (entry != bucket_map.end()) {
+    SSLSession *node = entry->second;
+    bucket_map.erase(entry);
+    queue.remove(node);
+    delete node;
+    if (ssl_rsb) {
+      SSL_DECREMENT_DYN_STAT(ssl_session_cache_entries);
     }
-    node = node->link.next;
   }
+  ink_rwlock_unlock(&lock);
 }
 
 /* Session Bucket */
-SSLSessionBucket::SSLSessionBucket() : mutex(new_ProxyMutex()) {}
+SSLSessionBucket::SSLSessionBucket()
+{
+  ink_rwlock_init(&lock);
+}
 
-SSLSessionBucket::~SSLSessionBucket() {}
+SSLSessionBucket::~SSLSessionBucket()
+{
+  while (SSLSession *node = queue.pop()) {
+    delete node;
+  }
+  ink_rwlock_destroy(&lock);
+}
@@ -24,6 +24,7 @@
 #include "ts/Map.h"
 #include "ts/List.h"
 #include "ts/ink_mutex.h"
+#include "ts/ink_rwlock.h"
 #include "P_EventSystem.h"
 #include "P_AIO.h"
 #include "I_RecProcess.h"
@@ -32,6 +33,9 @@
 #include "ts/RbTree.h"
 #include "ts/apidefs.h"
 #include <openssl/ssl.h>
+#include <atomic>
+#include <map>
+#include <string>
 
 #define SSL_MAX_SESSION_SIZE 256
 
@@ -118,15 +122,22 @@ public:
   SSLSessionID session_id;
   Ptr<IOBufferData> asn1_data; /* this is the ASN1 representation of the SSL_CTX */
   size_t len_asn1_data;
+  std::atomic<bool> referenced; /* set by lookups, cleared by the eviction clock */
 
   SSLSession(const SSLSessionID &id, Ptr<IOBufferData> ssl_asn1_data, size_t len_asn1)
-    : session_id(id), asn1_data(ssl_asn1_data), len_asn1_data(len_asn1)
+    : session_id(id), asn1_data(ssl_asn1_data), len_asn1_data(len_asn1), referenced(false)
   {
   }
 
   LINK(SSLSession, link);
 };
 
+/*
+  Sessions are indexed by id in a map and kept in insertion order in a queue. Lookups only take the
+  bucket lock shared, so concurrent handshakes resuming from the same bucket do not contend. When
+  the bucket is full the queue is swept as a clock: sessions looked up since the last sweep get a
+  second chance, the first one that was not is evicted.
+ */
 class SSLSessionBucket
 {
 public:
@@ -136,13 +147,18 @@ public:
   bool getSession(const SSLSessionID &, SSL_SESSION **ctx);
   int getSessionBuffer(const SSLSessionID &, char *buffer, int &len);
   void removeSession(const SSLSessionID &);
+  int appendSnapshot(std::string &snapshot);
 
 private:
+  bool readLock();
+  bool writeLock();
+
   /* these method must be used while hold the lock */
   void print(const char *) const;
   void removeOldestSession();
 
-  Ptr<ProxyMutex> mutex;
+  ink_rwlock lock;
+  std::map<SSLSessionID, SSLSession *> bucket_map;
   CountQueue<SSLSession> queue;
 };
 
@@ -153,6 +169,8 @@ public:
   int getSessionBuffer(const SSLSessionID &sid, char *buffer, int &len) const;
   void insertSession(const SSLSessionID &sid, SSL_SESSION *sess);
   void removeSession(const SSLSessionID &sid);
+  int loadSnapshot(const char *path);
+  int saveSnapshot(const char *path) const;
   SSLSessionCache();
   ~SSLSessionCache();
 
@@ -1057,6 +1057,18 @@ SSLInitializeStatistics()
   RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.ssl_session_cache_lock_contention", RECD_COUNTER, RECP_PERSISTENT,
                      (int)ssl_session_cache_lock_contention, RecRawStatSyncCount);
 
+  RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.ssl_session_cache_lru_eviction", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)ssl_session_cache_lru_eviction, RecRawStatSyncCount);
+
+  RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.ssl_session_cache_entries", RECD_INT, RECP_NON_PERSISTENT,
+                     (int)ssl_session_cache_entries, RecRawStatSyncSum);
+
+  RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.ssl_session_cache_snapshot_loaded", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)ssl_session_cache_snapshot_loaded, RecRawStatSyncCount);
+
+  RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.ssl_session_cache_snapshot_saved", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)ssl_session_cache_snapshot_saved, RecRawStatSyncCount);
+
   /* error stats */
   RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.ssl_error_want_write", RECD_COUNTER, RECP_PERSISTENT,
                      (int)ssl_error_want_write, RecRawStatSyncCount);
@@ -1085,6 +1097,14 @@ SSLInitializeStatistics()
   RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.ssl_ocsp_refresh_cert_failure", RECD_INT, RECP_PERSISTENT,
                      (int)ssl_ocsp_refresh_cert_failure_stat, RecRawStatSyncCount);
 
+  /* kernel TLS stats */
+  RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.ktls.send", RECD_COUNTER, RECP_PERSISTENT, (int)ssl_ktls_send_stat,
+                     RecRawStatSyncCount);
+  RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.ktls.recv", RECD_COUNTER, RECP_PERSISTENT, (int)ssl_ktls_recv_stat,
+                     RecRawStatSyncCount);
+  RecRegisterRawStat(ssl_rsb, RECT_PROCESS, "proxy.process.ssl.ktls.fallback", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)ssl_ktls_fallback_stat, RecRawStatSyncCount);
+
   // Get and register the SSL cipher stats. Note that we are using the default SSL context to obtain
   // the cipher list. This means that the set of ciphers is fixed by the build configuration and not
   // filtered by proxy.config.ssl.server.cipher_suite. This keeps the set of cipher suites stable across
@@ -1115,6 +1135,14 @@ SSLInitializeStatistics()
                          (int)ssl_cipher_stats_start + index, RecRawStatSyncSum);
       SSL_CLEAR_DYN_STAT((int)ssl_cipher_stats_start + index);
       Debug("ssl", "registering SSL cipher metric '%s'", statName.c_str());
+
+#if TS_HAS_KTLS
+      // Connections of the cipher which got kernel TLS offload, indexed in parallel to the cipher stats.
+      statName = "proxy.process.ssl.ktls.cipher." + std::string(cipherName);
+      RecRegisterRawStat(ssl_rsb, RECT_PROCESS, statName.c_str(), RECD_INT, RECP_NON_PERSISTENT,
+                         (int)ssl_ktls_cipher_stats_start + index, RecRawStatSyncSum);
+      SSL_CLEAR_DYN_STAT((int)ssl_ktls_cipher_stats_start + index);
+#endif
     }
   }
 
@@ -1122,6 +1150,19 @@ SSLInitializeStatistics()
   SSLReleaseContext(ctx);
 }
 
+void
+SSLIncrementKtlsCipherStat(const SSL *ssl)
+{
+  const SSL_CIPHER *cipher = SSL_get_current_cipher(ssl);
+  if (cipher) {
+    // The kTLS stats are laid out in parallel to the cipher stats.
+    auto data = cipher_map.get(SSL_CIPHER_get_name(cipher));
+    if (data != 0) {
+      SSL_INCREMENT_DYN_STAT(data - ssl_cipher_stats_start + ssl_ktls_cipher_stats_start);
+    }
+  }
+}
+
 // return true if we have a stat for the error
 static bool
 increment_ssl_client_error(unsigned long err)
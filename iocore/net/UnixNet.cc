@@ -95,6 +95,7 @@ public:
     // Cleanup the active and keep-alive queues periodically
     nh.manage_active_queue(true); // close any connections over the active timeout
     nh.manage_keep_alive_queue();
+    nh.manage_zerocopy_linger(now);
 
     return 0;
   }
@@ -152,6 +153,13 @@ PollCont::do_poll(ink_hrtime timeout)
   }
 // wait for fd's to tigger, or don't wait if timeout is 0
 #if TS_USE_EPOLL
+#if TS_USE_LINUX_IO_URING
+  if (pollDescriptor->uring) {
+    pollDescriptor->uring_poll(poll_timeout);
+    NetDebug("iocore_net_poll", "[PollCont::pollEvent] io_uring timeout: %d, results: %d", poll_timeout, pollDescriptor->result);
+    return;
+  }
+#endif
   pollDescriptor->result =
     epoll_wait(pollDescriptor->epoll_fd, pollDescriptor->ePoll_Triggered_Events, POLL_DESCRIPTOR_SIZE, poll_timeout);
   NetDebug("iocore_net_poll", "[PollCont::pollEvent] epoll_fd: %d, timeout: %d, results: %d", pollDescriptor->epoll_fd,
@@ -223,6 +231,12 @@ initialize_thread_for_net(EThread *thread)
   PollCont *pc       = get_PollCont(thread);
   PollDescriptor *pd = pc->pollDescriptor;
 
+#if TS_USE_EPOLL && TS_USE_LINUX_IO_URING
+  if (net_config_io_uring_enabled) {
+    pd->uring_start(net_config_io_uring_entries);
+  }
+#endif
+
   InactivityCop *inactivityCop = new InactivityCop(get_NetHandler(thread)->mutex);
   int cop_freq                 = 1;
 
@@ -345,6 +359,55 @@ NetHandler::free_netvc(UnixNetVConnection *netvc)
   netvc->free(t);
 }
 
+#if TS_HAS_MSG_ZEROCOPY
+// How long to wait for the kernel to release the buffers of a closed connection.
+static const ink_hrtime ZEROCOPY_LINGER_TIMEOUT = HRTIME_SECONDS(30);
+
+void
+NetHandler::zerocopy_linger(ZeroCopyTracker *zc, int fd)
+{
+  // Send the FIN now, as close() would have done, but keep the error queue readable.
+  shutdown(fd, SHUT_RDWR);
+  zc->fd           = fd;
+  zc->linger_until = Thread::get_hrtime() + ZEROCOPY_LINGER_TIMEOUT;
+  zerocopy_linger_list.enqueue(zc);
+}
+
+void
+NetHandler::manage_zerocopy_linger(ink_hrtime now)
+{
+  ZeroCopyTracker *next = nullptr;
+
+  for (ZeroCopyTracker *zc = zerocopy_linger_list.head; zc != nullptr; zc = next) {
+    next = zc->link.next;
+
+    int in_flight = zc->reap(zc->fd);
+    if (in_flight > 0 && zc->linger_until > now) {
+      continue;
+    }
+    if (in_flight > 0) {
+      // Reset the connection so the kernel drops the data it still has, before the buffers go away.
+      struct linger l = {1, 0};
+      safe_setsockopt(zc->fd, SOL_SOCKET, SO_LINGER, reinterpret_cast<char *>(&l), sizeof(l));
+    }
+    zerocopy_linger_list.remove(zc);
+    socketManager.close(zc->fd);
+    delete zc;
+  }
+}
+#else
+void
+NetHandler::zerocopy_linger(ZeroCopyTracker *, int fd)
+{
+  socketManager.close(fd);
+}
+
+void
+NetHandler::manage_zerocopy_linger(ink_hrtime)
+{
+}
+#endif
+
 //
 // Move VC's enabled on a different thread to the ready list
 //
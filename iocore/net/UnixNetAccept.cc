@@ -23,6 +23,10 @@
 
 #include "P_Net.h"
 
+#if defined(SO_ATTACH_REUSEPORT_CBPF)
+#include <linux/filter.h>
+#endif
+
 #ifdef ROUNDUP
 #undef ROUNDUP
 #endif
@@ -188,10 +192,36 @@ NetAccept::init_accept(EThread *t)
   t->schedule_every(this, period, opt.etype);
 }
 
+#if defined(SO_ATTACH_REUSEPORT_CBPF)
+//
+// Attach a classic BPF program to the SO_REUSEPORT group of @a fd which
+// selects the listen socket by the CPU that handled the incoming packet.
+// Sockets are indexed in the order they were put into listen state, which
+// is the order of the event threads, so with one net thread bound per CPU
+// a connection is accepted on the same core that received it.
+//
+static int
+attach_reuseport_cpu_steering(int fd, unsigned n)
+{
+  struct sock_filter code[] = {
+    {BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)}, // A = raw_smp_processor_id()
+    {BPF_ALU | BPF_MOD | BPF_K, 0, 0, n},                                           // A = A % n
+    {BPF_RET | BPF_A, 0, 0, 0},                                                       // return A
+  };
+  struct sock_fprog prog;
+
+  prog.len    = sizeof(code) / sizeof(code[0]);
+  prog.filter = code;
+  return safe_setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, reinterpret_cast<char *>(&prog), sizeof(prog));
+}
+#endif
+
 void
 NetAccept::init_accept_per_thread()
 {
   int i, n;
+  bool reuseport = opt.f_reuseport;
+  bool inherited = server.fd != NO_FD;
 
   ink_assert(opt.etype >= 0);
 
@@ -199,6 +229,19 @@ NetAccept::init_accept_per_thread()
     return;
   }
 
+  // A socket can only join a SO_REUSEPORT group opened by the same effective
+  // user. The sockets handed over by traffic_manager are bound before it drops
+  // privileges, so the per thread sockets would be refused by the kernel.
+  if (reuseport && inherited) {
+    struct stat st;
+    if (fstat(server.fd, &st) == 0 && st.st_uid != geteuid()) {
+      Warning("the listen socket for port %d is owned by uid %d but traffic_server runs as uid %d, SO_REUSEPORT sockets can "
+              "not join it, sharing the main socket",
+              ntohs(server.accept_addr.port()), static_cast<int>(st.st_uid), static_cast<int>(geteuid()));
+      reuseport = false;
+    }
+  }
+
   if (accept_fn == net_accept) {
     SET_HANDLER((NetAcceptHandler)&NetAccept::acceptFastEvent);
   } else {
@@ -208,15 +251,42 @@ NetAccept::init_accept_per_thread()
   period = -HRTIME_MSECONDS(net_accept_period);
   n      = eventProcessor.thread_group[opt.etype]._count;
 
-  for (i = 0; i < n; i++) {
-    NetAccept *a;
+  // Create all of the accepts before any of them is scheduled, the template
+  // goes to the first thread so its socket is the first in the SO_REUSEPORT group.
+  std::vector<NetAccept *> accepts(n, this);
+  for (i = 1; i < n; i++) {
+    NetAccept *a = clone();
+    a->peers.clear();
+
+    if (reuseport) {
+      a->server.fd = NO_FD;
+      if (a->server.listen(NON_BLOCKING, opt) == 0) {
+        peers.push_back(a);
+      } else {
+        Warning("unable to open a SO_REUSEPORT listen socket for port %d, sharing the main socket",
+                ntohs(server.accept_addr.port()));
+        a->server.fd = server.fd;
+        reuseport    = false;
+      }
+    }
+    accepts[i] = a;
+  }
 
-    if (i < n - 1) {
-      a = clone();
-    } else {
-      a = this;
+  if (reuseport && n > 1) {
+    Debug("iocore_net_accept_start", "Opened %d SO_REUSEPORT listen sockets for port %d", n, ntohs(server.accept_addr.port()));
+#if defined(SO_ATTACH_REUSEPORT_CBPF)
+    if (opt.f_reuseport_cpu_steering && attach_reuseport_cpu_steering(server.fd, n) < 0) {
+      Warning("unable to attach the CPU steering program to port %d: %s", ntohs(server.accept_addr.port()), strerror(errno));
+    }
+#else
+    if (opt.f_reuseport_cpu_steering) {
+      Warning("SO_REUSEPORT CPU steering is not supported on this platform");
     }
+#endif
+  }
 
+  for (i = 0; i < n; i++) {
+    NetAccept *a       = accepts[i];
     EThread *t         = eventProcessor.thread_group[opt.etype]._thread[i];
     PollDescriptor *pd = get_PollDescriptor(t);
 
@@ -224,8 +294,8 @@ NetAccept::init_accept_per_thread()
       Warning("[NetAccept::init_accept_per_thread]:error starting EventIO");
     }
 
-    a->mutex = get_NetHandler(t)->mutex;
-    t->schedule_every(a, period, opt.etype);
+    a->mutex        = get_NetHandler(t)->mutex;
+    a->accept_event = t->schedule_every(a, period, opt.etype);
   }
 }
 
@@ -236,6 +306,20 @@ NetAccept::stop_accept()
     action_->cancel();
   }
   server.close();
+  // The peers own their sockets, stop their polling and periodic events before
+  // the fds are closed so a reused fd number is never accepted from.
+  for (auto peer : peers) {
+    SCOPED_MUTEX_LOCK(lock, peer->mutex, this_ethread());
+    peer->ep.stop();
+    if (peer->accept_event) {
+      peer->accept_event->cancel();
+      peer->accept_event = nullptr;
+    }
+    peer->server.close();
+    NET_DECREMENT_DYN_STAT(net_accepts_currently_open_stat);
+    delete peer;
+  }
+  peers.clear();
 }
 
 int
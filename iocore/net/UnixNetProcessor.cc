@@ -37,20 +37,22 @@ NetProcessor::AcceptOptions::reset()
 {
   local_port = 0;
   local_ip.invalidate();
-  accept_threads        = -1;
-  ip_family             = AF_INET;
-  etype                 = ET_NET;
-  f_callback_on_open    = false;
-  localhost_only        = false;
-  frequent_accept       = true;
-  backdoor              = false;
-  recv_bufsize          = 0;
-  send_bufsize          = 0;
-  sockopt_flags         = 0;
-  packet_mark           = 0;
-  packet_tos            = 0;
-  tfo_queue_length      = 0;
-  f_inbound_transparent = false;
+  accept_threads           = -1;
+  ip_family                = AF_INET;
+  etype                    = ET_NET;
+  f_callback_on_open       = false;
+  localhost_only           = false;
+  frequent_accept          = true;
+  backdoor                 = false;
+  recv_bufsize             = 0;
+  send_bufsize             = 0;
+  sockopt_flags            = 0;
+  packet_mark              = 0;
+  packet_tos               = 0;
+  tfo_queue_length         = 0;
+  f_inbound_transparent    = false;
+  f_reuseport              = false;
+  f_reuseport_cpu_steering = false;
   return *this;
 }
 
@@ -142,6 +144,12 @@ UnixNetProcessor::accept_internal(Continuation *cont, int fd, AcceptOptions cons
     na->mutex = cont->mutex;
   }
 
+  // Per thread listen sockets only make sense when accepting on the event threads.
+  if (na->opt.f_reuseport && (accept_threads > 0 || !opt.frequent_accept)) {
+    Debug("iocore_net_accept", "SO_REUSEPORT ignored for port %d, accept is not done per thread", opt.local_port);
+    na->opt.f_reuseport = false;
+  }
+
   if (opt.frequent_accept) { // true
     if (accept_threads > 0) {
       if (0 == na->do_listen(BLOCKING)) {
@@ -184,6 +192,9 @@ UnixNetProcessor::accept_internal(Continuation *cont, int fd, AcceptOptions cons
   // data on the socket ready to be read
   if (should_filter_int > 0) {
     setsockopt(na->server.fd, IPPROTO_TCP, TCP_DEFER_ACCEPT, &should_filter_int, sizeof(int));
+    for (auto peer : na->peers) {
+      setsockopt(peer->server.fd, IPPROTO_TCP, TCP_DEFER_ACCEPT, &should_filter_int, sizeof(int));
+    }
   }
 #endif
 
@@ -195,6 +206,9 @@ UnixNetProcessor::accept_internal(Continuation *cont, int fd, AcceptOptions cons
     if (setsockopt(na->server.fd, IPPROTO_TCP, TCP_INIT_CWND, &tcp_init_cwnd, sizeof(int)) != 0) {
       Error("Cannot set initial congestion window to %d", tcp_init_cwnd);
     }
+    for (auto peer : na->peers) {
+      setsockopt(peer->server.fd, IPPROTO_TCP, TCP_INIT_CWND, &tcp_init_cwnd, sizeof(int));
+    }
   }
 #endif
 
@@ -890,6 +890,7 @@ UnixNetVConnection::UnixNetVConnection()
     oob_ptr(nullptr),
     from_accept_thread(false),
     accept_object(nullptr),
+    zerocopy(nullptr),
     origin_trace(false),
     origin_trace_addr(nullptr),
     origin_trace_port(0)
@@ -916,6 +917,32 @@ UnixNetVConnection::net_read_io(NetHandler *nh, EThread *lthread)
   read_from_net(nh, this, lthread);
 }
 
+#if TS_HAS_MSG_ZEROCOPY
+// Check whether a write of @a towrite bytes should be sent with MSG_ZEROCOPY.
+// Only large writes are worth it, the completion notifications cost a syscall.
+static bool
+zerocopy_wanted(UnixNetVConnection *vc, int64_t towrite)
+{
+  if (net_config_zerocopy_threshold <= 0 || towrite < net_config_zerocopy_threshold || !vc->con.is_connected) {
+    return false;
+  }
+
+  if (vc->zerocopy == nullptr) {
+    vc->zerocopy = new ZeroCopyTracker;
+    if (safe_setsockopt(vc->con.fd, SOL_SOCKET, SO_ZEROCOPY, SOCKOPT_ON, sizeof(int)) < 0) {
+      Debug("iocore_net", "unable to set SO_ZEROCOPY on fd %d: %s", vc->con.fd, strerror(errno));
+      vc->zerocopy->disabled = true;
+    }
+  }
+
+  if (!vc->zerocopy->disabled) {
+    // Release whatever the kernel is done with before adding more.
+    vc->zerocopy->reap(vc->con.fd);
+  }
+  return !vc->zerocopy->disabled;
+}
+#endif
+
 // This code was pulled out of write_to_net so
 // I could overwrite it for the SSL implementation
 // (SSL read does not support overlapped i/o)
@@ -926,9 +953,15 @@ UnixNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &bu
   int64_t r                  = 0;
   int64_t try_to_write       = 0;
   IOBufferReader *tmp_reader = buf.reader()->clone();
+#if TS_HAS_MSG_ZEROCOPY
+  bool use_zerocopy = zerocopy_wanted(this, towrite);
+#endif
 
   do {
     IOVec tiovec[NET_MAX_IOV];
+#if TS_HAS_MSG_ZEROCOPY
+    IOBufferBlock *tblock[NET_MAX_IOV];
+#endif
     unsigned niov = 0;
     try_to_write  = 0;
 
@@ -953,6 +986,9 @@ UnixNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &bu
       // build an iov entry
       tiovec[niov].iov_len  = len;
       tiovec[niov].iov_base = tmp_reader->start();
+#if TS_HAS_MSG_ZEROCOPY
+      tblock[niov] = tmp_reader->block.get();
+#endif
       niov++;
 
       try_to_write += len;
@@ -987,6 +1023,29 @@ UnixNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &bu
         this->con.is_connected = true;
       }
 
+#if TS_HAS_MSG_ZEROCOPY
+    } else if (use_zerocopy) {
+      struct msghdr msg;
+
+      ink_zero(msg);
+      msg.msg_iov    = &tiovec[0];
+      msg.msg_iovlen = niov;
+
+      r = socketManager.sendmsg(con.fd, &msg, MSG_ZEROCOPY);
+      if (r > 0) {
+        // The blocks must outlive the send, which completes asynchronously.
+        this->zerocopy->sent(tblock, tiovec, niov, r);
+        NET_SUM_GLOBAL_DYN_STAT(net_zerocopy_sends_stat, 1);
+      } else if (r == -ENOBUFS || r == -EOPNOTSUPP) {
+        // Out of memory for the notifications, or a socket (e.g. kTLS) which can't
+        // send from user pages. Copy this time, and for good if it's not supported.
+        if (r == -EOPNOTSUPP) {
+          this->zerocopy->disabled = true;
+          use_zerocopy             = false;
+        }
+        r = socketManager.writev(con.fd, &tiovec[0], niov);
+      }
+#endif
     } else {
       r = socketManager.writev(con.fd, &tiovec[0], niov);
     }
@@ -1361,6 +1420,7 @@ UnixNetVConnection::free(EThread *t)
   if (con.fd != NO_FD) {
     NET_SUM_GLOBAL_DYN_STAT(net_connections_currently_open_stat, -1);
   }
+  release_zerocopy(t);
   con.close();
 
   clear();
@@ -1375,6 +1435,23 @@ UnixNetVConnection::free(EThread *t)
   }
 }
 
+void
+UnixNetVConnection::release_zerocopy(EThread *t)
+{
+#if TS_HAS_MSG_ZEROCOPY
+  if (zerocopy) {
+    if (con.fd != NO_FD && zerocopy->reap(con.fd) > 0) {
+      // The kernel may still be sending from our buffers, hand them over with the socket.
+      get_NetHandler(t)->zerocopy_linger(zerocopy, con.fd);
+      con.fd = NO_FD;
+    } else {
+      delete zerocopy;
+    }
+    zerocopy = nullptr;
+  }
+#endif
+}
+
 void
 UnixNetVConnection::apply_options()
 {
@@ -1463,6 +1540,10 @@ UnixNetVConnection::migrateToCurrentThread(Continuation *cont, EThread *t)
     }
     ink_assert(this->con.fd == NO_FD);
 
+    // The zero copy sends in flight are numbered per socket, the tracker goes with it.
+    ret_vc->zerocopy = this->zerocopy;
+    this->zerocopy   = nullptr;
+
     // Do_io_close will signal the VC to be freed on the original thread
     // Since we moved the con context, the fd will not be closed
     // Go ahead and remove the fd from the original thread's epoll structure, so it is not
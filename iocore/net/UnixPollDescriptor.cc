@@ -0,0 +1,235 @@
+/** @file
+
+  io_uring based polling for PollDescriptor.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "P_Net.h"
+
+#if TS_USE_EPOLL && TS_USE_LINUX_IO_URING
+
+// User data of requests whose completions are of no interest (poll removals).
+static constexpr uint64_t URING_IGNORE = ~static_cast<uint64_t>(0);
+// Poll bits passed to io_uring, EPOLLET has no meaning for a multishot poll.
+static constexpr uint32_t URING_POLL_MASK = EPOLLIN | EPOLLOUT | EPOLLPRI | EPOLLERR | EPOLLHUP | EPOLLRDHUP;
+
+static inline uint64_t
+uring_id(uint32_t slot, uint32_t gen)
+{
+  return (static_cast<uint64_t>(gen) << 32) | slot;
+}
+
+PollDescriptor::~PollDescriptor()
+{
+  if (uring) {
+    io_uring_queue_exit(uring);
+    delete uring;
+    ink_mutex_destroy(&uring_changes_lock);
+  }
+  ats_free(uring_cqes);
+}
+
+bool
+PollDescriptor::uring_start(unsigned entries)
+{
+  ink_assert(uring == nullptr);
+  struct io_uring *ring = new struct io_uring;
+
+  int ret = io_uring_queue_init(entries, ring, 0);
+  if (ret < 0) {
+    Warning("io_uring setup failed: %s (%d), using epoll", strerror(-ret), -ret);
+    delete ring;
+    return false;
+  }
+  ink_mutex_init(&uring_changes_lock);
+  uring        = ring;
+  uring_thread = this_ethread();
+  uring_cqes   = static_cast<struct io_uring_cqe **>(ats_malloc(sizeof(struct io_uring_cqe *) * POLL_DESCRIPTOR_SIZE));
+  return true;
+}
+
+struct io_uring_sqe *
+PollDescriptor::uring_get_sqe()
+{
+  struct io_uring_sqe *sqe = io_uring_get_sqe(uring);
+  if (sqe == nullptr) {
+    // The submission queue is full, flush it early.
+    io_uring_submit(uring);
+    sqe = io_uring_get_sqe(uring);
+  }
+  return sqe;
+}
+
+void
+PollDescriptor::uring_arm(uint32_t slot, int fd)
+{
+  struct io_uring_sqe *sqe = uring_get_sqe();
+  if (sqe == nullptr) {
+    Warning("io_uring submission queue full, dropping poll request for fd %d", fd);
+    return;
+  }
+  io_uring_prep_poll_multishot(sqe, fd, uring_slots[slot].events);
+  io_uring_sqe_set_data64(sqe, uring_id(slot, uring_slots[slot].gen));
+}
+
+void
+PollDescriptor::uring_add_slot(EventIO *eio, int fd, int events)
+{
+  uint32_t slot;
+
+  if (!uring_free_slots.empty()) {
+    slot = uring_free_slots.back();
+    uring_free_slots.pop_back();
+  } else {
+    slot = uring_slots.size();
+    uring_slots.emplace_back();
+  }
+
+  UringSlot &s  = uring_slots[slot];
+  s.eio         = eio;
+  s.events      = events & URING_POLL_MASK;
+  eio->uring_id = uring_id(slot, s.gen);
+  uring_arm(slot, fd);
+}
+
+int
+PollDescriptor::uring_remove_slot(EventIO *eio, uint64_t id)
+{
+  uint32_t slot = static_cast<uint32_t>(id);
+  uint32_t gen  = static_cast<uint32_t>(id >> 32);
+
+  if (slot >= uring_slots.size() || uring_slots[slot].eio != eio || uring_slots[slot].gen != gen) {
+    return 0;
+  }
+  // Bumping the generation invalidates completions already in flight.
+  uring_slots[slot].eio = nullptr;
+  ++uring_slots[slot].gen;
+  uring_free_slots.push_back(slot);
+
+  struct io_uring_sqe *sqe = uring_get_sqe();
+  if (sqe == nullptr) {
+    errno = EBUSY;
+    return -1;
+  }
+  io_uring_prep_poll_remove(sqe, id);
+  io_uring_sqe_set_data64(sqe, URING_IGNORE);
+  return 0;
+}
+
+int
+PollDescriptor::uring_add(EventIO *eio, int fd, int events)
+{
+  if (this_ethread() == uring_thread) {
+    uring_add_slot(eio, fd, events);
+    return 0;
+  }
+
+  {
+    ink_scoped_mutex_lock lock(uring_changes_lock);
+    uring_changes.push_back({eio, 0, fd, events, true});
+  }
+  // Wake the owning thread so the poll request is submitted without waiting for the poll timeout.
+  get_NetHandler(uring_thread)->signalActivity();
+  return 0;
+}
+
+int
+PollDescriptor::uring_remove(EventIO *eio)
+{
+  if (this_ethread() == uring_thread) {
+    return uring_remove_slot(eio, eio->uring_id);
+  }
+
+  // The caller may free the EventIO as soon as this returns, so a queued removal only carries its
+  // address for comparison and the id it was registered with.
+  ink_scoped_mutex_lock lock(uring_changes_lock);
+  for (auto spot = uring_changes.begin(); spot != uring_changes.end(); ++spot) {
+    if (spot->eio == eio && spot->add) {
+      // Never submitted, nothing to remove from the ring.
+      uring_changes.erase(spot);
+      return 0;
+    }
+  }
+  uring_changes.push_back({eio, eio->uring_id, eio->fd, 0, false});
+  return 0;
+}
+
+void
+PollDescriptor::uring_apply_changes()
+{
+  ink_scoped_mutex_lock lock(uring_changes_lock);
+  for (const UringChange &change : uring_changes) {
+    if (change.add) {
+      uring_add_slot(change.eio, change.fd, change.events);
+    } else {
+      uring_remove_slot(change.eio, change.id);
+    }
+  }
+  uring_changes.clear();
+}
+
+void
+PollDescriptor::uring_poll(int timeout_ms)
+{
+  struct io_uring_cqe *cqe = nullptr;
+  struct __kernel_timespec ts;
+
+  ts.tv_sec  = timeout_ms / 1000;
+  ts.tv_nsec = (timeout_ms % 1000) * 1000000LL;
+
+  // Removals from other threads must be applied before completions are looked at, the EventIO may be gone.
+  uring_apply_changes();
+
+  // Submits the queued poll additions and removals and waits, all in one call.
+  int ret = io_uring_submit_and_wait_timeout(uring, &cqe, 1, timeout_ms >= 0 ? &ts : nullptr, nullptr);
+  if (ret < 0 && ret != -ETIME && ret != -EINTR) {
+    Debug("iocore_net_poll", "io_uring_submit_and_wait_timeout failed: %s (%d)", strerror(-ret), -ret);
+  }
+
+  result     = 0;
+  unsigned n = io_uring_peek_batch_cqe(uring, uring_cqes, POLL_DESCRIPTOR_SIZE);
+  for (unsigned i = 0; i < n; ++i) {
+    uint64_t id = io_uring_cqe_get_data64(uring_cqes[i]);
+    if (id == URING_IGNORE) {
+      continue;
+    }
+
+    uint32_t slot = static_cast<uint32_t>(id);
+    uint32_t gen  = static_cast<uint32_t>(id >> 32);
+    if (slot >= uring_slots.size() || uring_slots[slot].gen != gen || uring_slots[slot].eio == nullptr) {
+      continue; // stale completion for a stopped EventIO
+    }
+
+    EventIO *eio = uring_slots[slot].eio;
+    int res      = uring_cqes[i]->res;
+    if (res != -ECANCELED) {
+      ePoll_Triggered_Events[result].events   = res >= 0 ? res : EPOLLERR;
+      ePoll_Triggered_Events[result].data.ptr = eio;
+      ++result;
+    }
+    // A multishot poll can be terminated by the kernel, re-arm it.
+    if (!(uring_cqes[i]->flags & IORING_CQE_F_MORE) && res >= 0) {
+      uring_arm(slot, eio->fd);
+    }
+  }
+  io_uring_cq_advance(uring, n);
+}
+
+#endif
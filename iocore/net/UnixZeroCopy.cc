@@ -0,0 +1,99 @@
+/** @file
+
+  Completion tracking for MSG_ZEROCOPY sends.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "P_Net.h"
+
+#if TS_HAS_MSG_ZEROCOPY
+
+#include <linux/errqueue.h>
+
+void
+ZeroCopyTracker::sent(IOBufferBlock *const *blocks, const IOVec *iov, unsigned niov, int64_t nbytes)
+{
+  uint32_t seq = next_seq++;
+
+  for (unsigned i = 0; i < niov && nbytes > 0; ++i) {
+    int64_t len = std::min(static_cast<int64_t>(iov[i].iov_len), nbytes);
+    pending.push_back({seq, len, make_ptr(blocks[i])});
+    nbytes -= len;
+  }
+  ++in_flight;
+}
+
+void
+ZeroCopyTracker::complete(uint32_t lo, uint32_t hi, bool copied)
+{
+  int64_t bytes = 0;
+
+  // Sequence numbers wrap, compare them relative to the start of the range.
+  for (auto &p : pending) {
+    if (p.block && p.seq - lo <= hi - lo) {
+      bytes += p.bytes;
+      p.block = nullptr;
+    }
+  }
+  while (!pending.empty() && !pending.front().block) {
+    pending.pop_front();
+  }
+  in_flight -= std::min(in_flight, hi - lo + 1);
+
+  if (copied) {
+    // The kernel could not send from our pages (e.g. loopback), so zero copy only adds overhead.
+    NET_SUM_GLOBAL_DYN_STAT(net_zerocopy_bytes_copied_stat, bytes);
+    disabled = true;
+  } else {
+    NET_SUM_GLOBAL_DYN_STAT(net_zerocopy_bytes_stat, bytes);
+  }
+}
+
+int
+ZeroCopyTracker::reap(int fd)
+{
+  char control[CMSG_SPACE(sizeof(struct sock_extended_err) + sizeof(struct sockaddr_in6))];
+
+  while (in_flight > 0) {
+    struct msghdr msg;
+
+    ink_zero(msg);
+    msg.msg_control    = control;
+    msg.msg_controllen = sizeof(control);
+    if (socketManager.recvmsg(fd, &msg, MSG_ERRQUEUE) < 0) {
+      break;
+    }
+
+    for (struct cmsghdr *cm = CMSG_FIRSTHDR(&msg); cm != nullptr; cm = CMSG_NXTHDR(&msg, cm)) {
+      if (!((cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR) ||
+            (cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR))) {
+        continue;
+      }
+      struct sock_extended_err *serr = reinterpret_cast<struct sock_extended_err *>(CMSG_DATA(cm));
+      if (serr->ee_origin == SO_EE_ORIGIN_ZEROCOPY && serr->ee_errno == 0) {
+        complete(serr->ee_info, serr->ee_data, serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED);
+      }
+    }
+  }
+
+  return in_flight;
+}
+
+#endif
@@ -20,12 +20,14 @@
  */
 
 #include "ConsistentHash.h"
+#include "ts/ink_assert.h"
 #include <cstring>
 #include <string>
 #include <sstream>
 #include <cmath>
 #include <climits>
 #include <cstdio>
+#include <algorithm>
 
 std::ostream &
 operator<<(std::ostream &os, ATSConsistentHashNode &thing)
@@ -33,10 +35,95 @@ operator<<(std::ostream &os, ATSConsistentHashNode &thing)
   return os << thing.name;
 }
 
-ATSConsistentHash::ATSConsistentHash(int r, ATSHash64 *h) : replicas(r), hash(h) {}
+void
+ATSConsistentHashTreeRing::insert(uint64_t hashval, ATSConsistentHashNode *node)
+{
+  NodeMap.insert(std::pair<uint64_t, ATSConsistentHashNode *>(hashval, node));
+}
+
+/*
+  The first point after i, wrapping around, owned by another node than the one of i, or end() if there
+  is no other node. wrapped is set when the end of the ring is passed.
+ */
+ATSConsistentHashTreeRing::iterator
+ATSConsistentHashTreeRing::next_node(iterator i, bool &wrapped)
+{
+  iterator j = i;
+
+  do {
+    if (++j == NodeMap.end()) {
+      wrapped = true;
+      j       = NodeMap.begin();
+    }
+  } while (j != i && j->second == i->second);
+
+  return j == i ? NodeMap.end() : j;
+}
+
+void
+ATSConsistentHashFlatRing::insert(uint64_t hashval, ATSConsistentHashNode *node)
+{
+  pending.push_back(std::make_pair(hashval, node));
+  finalized = false;
+}
+
+void
+ATSConsistentHashFlatRing::finalize()
+{
+  if (finalized) {
+    return;
+  }
+
+  // Like std::map::insert(), the first node inserted wins a hash collision.
+  typedef std::pair<uint64_t, ATSConsistentHashNode *> Point;
+  std::stable_sort(pending.begin(), pending.end(), [](const Point &a, const Point &b) { return a.first < b.first; });
+  for (const auto &point : pending) {
+    if (hashes.empty() || hashes.back() != point.first) {
+      hashes.push_back(point.first);
+      nodes.push_back(point.second);
+    }
+  }
+  pending.clear();
+  pending.shrink_to_fit();
+
+  // next_nodes[i] is the first point after i, wrapping around, owned by another node, or size() if
+  // there is only one node. Two passes backwards settle the runs that wrap around the end.
+  uint32_t n = hashes.size();
+  next_nodes.assign(n, n);
+  for (uint32_t k = 2 * n; k > 0; --k) {
+    uint32_t i    = (k - 1) % n;
+    uint32_t j    = (i + 1) % n;
+    next_nodes[i] = nodes[j] != nodes[i] ? j : next_nodes[j];
+  }
+  finalized = true;
+}
+
+ATSConsistentHashFlatRing::iterator
+ATSConsistentHashFlatRing::find(uint64_t hashval)
+{
+  ink_assert(finalized);
+  return std::lower_bound(hashes.begin(), hashes.end(), hashval) - hashes.begin();
+}
+
+ATSConsistentHashFlatRing::iterator
+ATSConsistentHashFlatRing::next_node(iterator i, bool &wrapped)
+{
+  iterator next = next_nodes[i];
+
+  if (next >= size()) {
+    return size();
+  }
+  if (next <= i) {
+    wrapped = true;
+  }
+  return next;
+}
 
+template <class Ring> ATSConsistentHashBase<Ring>::ATSConsistentHashBase(int r, ATSHash64 *h) : replicas(r), hash(h) {}
+
+template <class Ring>
 void
-ATSConsistentHash::insert(ATSConsistentHashNode *node, float weight, ATSHash64 *h)
+ATSConsistentHashBase<Ring>::insert(ATSConsistentHashNode *node, float weight, ATSHash64 *h)
 {
   int i;
   char numstr[256];
@@ -60,16 +147,27 @@ ATSConsistentHash::insert(ATSConsistentHashNode *node, float weight, ATSHash64 *
     thash->update(numstr, strlen(numstr));
     thash->update(std_string.c_str(), strlen(std_string.c_str()));
     thash->final();
-    NodeMap.insert(std::pair<uint64_t, ATSConsistentHashNode *>(thash->get(), node));
+    ring.insert(thash->get(), node);
     thash->clear();
   }
 }
 
+/*
+  Must be called after the last insert() and before any lookup.
+ */
+template <class Ring>
+void
+ATSConsistentHashBase<Ring>::finalize()
+{
+  ring.finalize();
+}
+
+template <class Ring>
 ATSConsistentHashNode *
-ATSConsistentHash::lookup(const char *url, ATSConsistentHashIter *i, bool *w, ATSHash64 *h)
+ATSConsistentHashBase<Ring>::lookup(const char *url, Iter *i, bool *w, ATSHash64 *h)
 {
   uint64_t url_hash;
-  ATSConsistentHashIter NodeMapIterUp, *iter;
+  Iter NodeIterUp = ring.end(), *iter;
   ATSHash64 *thash;
   bool *wptr, wrapped = false;
 
@@ -90,7 +188,7 @@ ATSConsistentHash::lookup(const char *url, ATSConsistentHashIter *i, bool *w, AT
   if (i) {
     iter = i;
   } else {
-    iter = &NodeMapIterUp;
+    iter = &NodeIterUp;
   }
 
   if (url) {
@@ -99,33 +197,34 @@ ATSConsistentHash::lookup(const char *url, ATSConsistentHashIter *i, bool *w, AT
     url_hash = thash->get();
     thash->clear();
 
-    *iter = NodeMap.lower_bound(url_hash);
+    *iter = ring.find(url_hash);
 
-    if (*iter == NodeMap.end()) {
+    if (*iter == ring.end()) {
       *wptr = true;
-      *iter = NodeMap.begin();
+      *iter = ring.begin();
     }
-  } else {
-    (*iter)++;
+  } else if (*iter != ring.end()) {
+    *iter = ring.next(*iter);
   }
 
-  if (!(*wptr) && *iter == NodeMap.end()) {
+  if (!(*wptr) && *iter == ring.end()) {
     *wptr = true;
-    *iter = NodeMap.begin();
+    *iter = ring.begin();
   }
 
-  if (*wptr && *iter == NodeMap.end()) {
+  if (*iter == ring.end()) {
     return nullptr;
   }
 
-  return (*iter)->second;
+  return ring.node(*iter);
 }
 
+template <class Ring>
 ATSConsistentHashNode *
-ATSConsistentHash::lookup_available(const char *url, ATSConsistentHashIter *i, bool *w, ATSHash64 *h)
+ATSConsistentHashBase<Ring>::lookup_available(const char *url, Iter *i, bool *w, ATSHash64 *h)
 {
   uint64_t url_hash;
-  ATSConsistentHashIter NodeMapIterUp, *iter;
+  Iter NodeIterUp = ring.end(), *iter;
   ATSHash64 *thash;
   bool *wptr, wrapped = false;
 
@@ -146,7 +245,7 @@ ATSConsistentHash::lookup_available(const char *url, ATSConsistentHashIter *i, b
   if (i) {
     iter = i;
   } else {
-    iter = &NodeMapIterUp;
+    iter = &NodeIterUp;
   }
 
   if (url) {
@@ -155,32 +254,33 @@ ATSConsistentHash::lookup_available(const char *url, ATSConsistentHashIter *i, b
     url_hash = thash->get();
     thash->clear();
 
-    *iter = NodeMap.lower_bound(url_hash);
+    *iter = ring.find(url_hash);
   }
 
-  if (*iter == NodeMap.end()) {
+  if (*iter == ring.end()) {
     *wptr = true;
-    *iter = NodeMap.begin();
+    *iter = ring.begin();
   }
 
-  while (!(*iter)->second->available) {
-    (*iter)++;
+  if (*iter == ring.end()) {
+    return nullptr;
+  }
 
-    if (!(*wptr) && *iter == NodeMap.end()) {
-      *wptr = true;
-      *iter = NodeMap.begin();
-    } else if (*wptr && *iter == NodeMap.end()) {
+  // Jump over all the consecutive points of an unavailable node at once.
+  while (!ring.node(*iter)->available) {
+    if (lookup_next_node(iter, wptr) == nullptr) {
       return nullptr;
     }
   }
 
-  return (*iter)->second;
+  return ring.node(*iter);
 }
 
+template <class Ring>
 ATSConsistentHashNode *
-ATSConsistentHash::lookup_by_hashval(uint64_t hashval, ATSConsistentHashIter *i, bool *w)
+ATSConsistentHashBase<Ring>::lookup_by_hashval(uint64_t hashval, Iter *i, bool *w)
 {
-  ATSConsistentHashIter NodeMapIterUp, *iter;
+  Iter NodeIterUp, *iter;
   bool *wptr, wrapped = false;
 
   if (w) {
@@ -192,22 +292,61 @@ ATSConsistentHash::lookup_by_hashval(uint64_t hashval, ATSConsistentHashIter *i,
   if (i) {
     iter = i;
   } else {
-    iter = &NodeMapIterUp;
+    iter = &NodeIterUp;
   }
 
-  *iter = NodeMap.lower_bound(hashval);
+  *iter = ring.find(hashval);
 
-  if (*iter == NodeMap.end()) {
+  if (*iter == ring.end()) {
     *wptr = true;
-    *iter = NodeMap.begin();
+    *iter = ring.begin();
   }
 
-  return (*iter)->second;
+  if (*iter == ring.end()) {
+    return nullptr;
+  }
+
+  return ring.node(*iter);
 }
 
-ATSConsistentHash::~ATSConsistentHash()
+/*
+  Move to the next point owned by a different node than the current one. Returns nullptr when the
+  ring has already wrapped around once or when there is no other node.
+ */
+template <class Ring>
+ATSConsistentHashNode *
+ATSConsistentHashBase<Ring>::lookup_next_node(Iter *i, bool *w)
+{
+  bool passed_end = false;
+
+  if (*i == ring.end()) {
+    return nullptr;
+  }
+
+  Iter next = ring.next_node(*i, passed_end);
+  if (next == ring.end()) {
+    *w = true;
+    *i = ring.end();
+    return nullptr;
+  }
+  if (passed_end) {
+    if (*w) {
+      *i = ring.end();
+      return nullptr;
+    }
+    *w = true;
+  }
+  *i = next;
+
+  return ring.node(next);
+}
+
+template <class Ring> ATSConsistentHashBase<Ring>::~ATSConsistentHashBase()
 {
   if (hash) {
     delete hash;
   }
 }
+
+template struct ATSConsistentHashBase<ATSConsistentHashTreeRing>;
+template struct ATSConsistentHashBase<ATSConsistentHashFlatRing>;
@@ -25,6 +25,7 @@
 #include <cstdint>
 #include <iostream>
 #include <map>
+#include <vector>
 
 /*
   Helper class to be extended to make ring nodes.
@@ -37,26 +38,134 @@ struct ATSConsistentHashNode {
 
 std::ostream &operator<<(std::ostream &os, ATSConsistentHashNode &thing);
 
-typedef std::map<uint64_t, ATSConsistentHashNode *>::iterator ATSConsistentHashIter;
+/*
+  Ring of hash points kept in a std::map.
+ */
+
+struct ATSConsistentHashTreeRing {
+  typedef std::map<uint64_t, ATSConsistentHashNode *>::iterator iterator;
+
+  void insert(uint64_t hashval, ATSConsistentHashNode *node);
+  void
+  finalize()
+  {
+  }
+  iterator
+  begin()
+  {
+    return NodeMap.begin();
+  }
+  iterator
+  end()
+  {
+    return NodeMap.end();
+  }
+  iterator
+  find(uint64_t hashval)
+  {
+    return NodeMap.lower_bound(hashval);
+  }
+  iterator
+  next(iterator i)
+  {
+    return ++i;
+  }
+  iterator next_node(iterator i, bool &wrapped);
+  ATSConsistentHashNode *
+  node(iterator i) const
+  {
+    return i->second;
+  }
+  size_t
+  size() const
+  {
+    return NodeMap.size();
+  }
+
+private:
+  std::map<uint64_t, ATSConsistentHashNode *> NodeMap;
+};
+
+/*
+  Ring of hash points kept in a sorted array that is binary searched.
+
+  For every point the index of the next point owned by another node is precomputed, so skipping the
+  replicas of an unavailable node does not visit them one by one. finalize() must be called after the
+  last insert() and before any lookup.
+ */
+
+struct ATSConsistentHashFlatRing {
+  typedef uint32_t iterator;
+
+  void insert(uint64_t hashval, ATSConsistentHashNode *node);
+  void finalize();
+  iterator
+  begin()
+  {
+    return 0;
+  }
+  iterator
+  end()
+  {
+    return hashes.size();
+  }
+  iterator find(uint64_t hashval);
+  iterator
+  next(iterator i)
+  {
+    return i + 1;
+  }
+  iterator next_node(iterator i, bool &wrapped);
+  ATSConsistentHashNode *
+  node(iterator i) const
+  {
+    return nodes[i];
+  }
+  size_t
+  size() const
+  {
+    return hashes.size();
+  }
+
+private:
+  bool finalized = true;
+  std::vector<std::pair<uint64_t, ATSConsistentHashNode *>> pending;
+  std::vector<uint64_t> hashes;
+  std::vector<ATSConsistentHashNode *> nodes;
+  std::vector<uint32_t> next_nodes;
+};
 
 /*
   TSConsistentHash requires a TSHash64 object
 
-  Caller is responsible for freeing ring node memory.
+  Caller is responsible for freeing ring node memory. Ring is where the hash points are kept,
+  ATSConsistentHashTreeRing or ATSConsistentHashFlatRing; both map a URL to the same node.
  */
 
-struct ATSConsistentHash {
-  ATSConsistentHash(int r = 1024, ATSHash64 *h = nullptr);
+template <class Ring> struct ATSConsistentHashBase {
+  typedef typename Ring::iterator Iter;
+
+  ATSConsistentHashBase(int r = 1024, ATSHash64 *h = nullptr);
   void insert(ATSConsistentHashNode *node, float weight = 1.0, ATSHash64 *h = nullptr);
-  ATSConsistentHashNode *lookup(const char *url = nullptr, ATSConsistentHashIter *i = nullptr, bool *w = nullptr,
-                                ATSHash64 *h = nullptr);
-  ATSConsistentHashNode *lookup_available(const char *url = nullptr, ATSConsistentHashIter *i = nullptr, bool *w = nullptr,
-                                          ATSHash64 *h = nullptr);
-  ATSConsistentHashNode *lookup_by_hashval(uint64_t hashval, ATSConsistentHashIter *i = nullptr, bool *w = nullptr);
-  ~ATSConsistentHash();
+  void finalize();
+  ATSConsistentHashNode *lookup(const char *url = nullptr, Iter *i = nullptr, bool *w = nullptr, ATSHash64 *h = nullptr);
+  ATSConsistentHashNode *lookup_available(const char *url = nullptr, Iter *i = nullptr, bool *w = nullptr, ATSHash64 *h = nullptr);
+  ATSConsistentHashNode *lookup_by_hashval(uint64_t hashval, Iter *i = nullptr, bool *w = nullptr);
+  ATSConsistentHashNode *lookup_next_node(Iter *i, bool *w);
+  size_t
+  size() const
+  {
+    return ring.size();
+  }
+  ~ATSConsistentHashBase();
 
 private:
   int replicas;
   ATSHash64 *hash;
-  std::map<uint64_t, ATSConsistentHashNode *> NodeMap;
+  Ring ring;
 };
+
+typedef ATSConsistentHashBase<ATSConsistentHashTreeRing> ATSConsistentHash;
+typedef ATSConsistentHashBase<ATSConsistentHashFlatRing> ATSFlatConsistentHash;
+typedef ATSConsistentHash::Iter ATSConsistentHashIter;
+typedef ATSFlatConsistentHash::Iter ATSFlatConsistentHashIter;
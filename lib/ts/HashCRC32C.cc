@@ -0,0 +1,154 @@
+/** @file
+
+  CRC-32C (Castagnoli), as used by iSCSI and SCTP.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "ts/HashCRC32C.h"
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define CRC32C_HARDWARE 1
+#endif
+
+namespace
+{
+const uint32_t CRC32C_POLY = 0x82f63b78; // Castagnoli polynomial, bit reversed
+
+// Slicing by 8: table i holds the CRC of a byte followed by i zero bytes.
+struct CRC32CTables {
+  uint32_t t[8][256];
+
+  CRC32CTables()
+  {
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; ++k) {
+        c = (c >> 1) ^ (CRC32C_POLY & (0 - (c & 1)));
+      }
+      t[0][i] = c;
+    }
+    for (uint32_t i = 0; i < 256; ++i) {
+      for (int j = 1; j < 8; ++j) {
+        t[j][i] = (t[j - 1][i] >> 8) ^ t[0][t[j - 1][i] & 0xff];
+      }
+    }
+  }
+};
+
+uint32_t
+crc32c_software(uint32_t crc, const uint8_t *p, size_t len)
+{
+  static const CRC32CTables tables;
+  const uint32_t(*t)[256] = tables.t;
+
+  for (; len >= 8; p += 8, len -= 8) {
+    uint32_t lo = crc ^ (p[0] | p[1] << 8 | p[2] << 16 | static_cast<uint32_t>(p[3]) << 24);
+    uint32_t hi = p[4] | p[5] << 8 | p[6] << 16 | static_cast<uint32_t>(p[7]) << 24;
+    crc         = t[7][lo & 0xff] ^ t[6][(lo >> 8) & 0xff] ^ t[5][(lo >> 16) & 0xff] ^ t[4][lo >> 24] ^ t[3][hi & 0xff] ^
+          t[2][(hi >> 8) & 0xff] ^ t[1][(hi >> 16) & 0xff] ^ t[0][hi >> 24];
+  }
+  for (; len; ++p, --len) {
+    crc = t[0][(crc ^ *p) & 0xff] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+#if CRC32C_HARDWARE
+__attribute__((target("sse4.2"))) uint32_t
+crc32c_hardware(uint32_t crc, const uint8_t *p, size_t len)
+{
+  for (; len && (reinterpret_cast<uintptr_t>(p) & 7); ++p, --len) {
+    crc = _mm_crc32_u8(crc, *p);
+  }
+  uint64_t c = crc;
+  for (; len >= 8; p += 8, len -= 8) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    c = _mm_crc32_u64(c, v);
+  }
+  crc = static_cast<uint32_t>(c);
+  for (; len; ++p, --len) {
+    crc = _mm_crc32_u8(crc, *p);
+  }
+  return crc;
+}
+#endif
+
+using CRC32CFunc = uint32_t (*)(uint32_t, const uint8_t *, size_t);
+
+CRC32CFunc
+crc32c_select()
+{
+#if CRC32C_HARDWARE
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("sse4.2")) {
+    return crc32c_hardware;
+  }
+#endif
+  return crc32c_software;
+}
+
+CRC32CFunc
+crc32c_func()
+{
+  static const CRC32CFunc func = crc32c_select();
+  return func;
+}
+} // namespace
+
+ATSHash32CRC32C::ATSHash32CRC32C()
+{
+  this->clear();
+}
+
+void
+ATSHash32CRC32C::update(const void *data, size_t len)
+{
+  crc = crc32c_func()(crc, static_cast<const uint8_t *>(data), len);
+}
+
+void
+ATSHash32CRC32C::final()
+{
+}
+
+uint32_t
+ATSHash32CRC32C::get() const
+{
+  return ~crc;
+}
+
+void
+ATSHash32CRC32C::clear()
+{
+  crc = 0xffffffff;
+}
+
+bool
+ATSHash32CRC32C::hardware()
+{
+#if CRC32C_HARDWARE
+  return crc32c_func() == crc32c_hardware;
+#else
+  return false;
+#endif
+}
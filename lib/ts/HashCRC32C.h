@@ -0,0 +1,48 @@
+/** @file
+
+  CRC-32C (Castagnoli), as used by iSCSI and SCTP.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "ts/Hash.h"
+#include <cstdint>
+
+/** CRC-32C of a byte stream.
+
+    On x86_64 processors with SSE4.2 the crc32 instruction is used, it is checked for at run time so
+    the build does not need to target SSE4.2. Everywhere else a table driven version gives the same
+    result.
+ */
+struct ATSHash32CRC32C : ATSHash32 {
+  ATSHash32CRC32C(void);
+
+  void update(const void *data, size_t len) override;
+  void final(void) override;
+  uint32_t get(void) const override;
+  void clear(void) override;
+
+  /// Whether update() uses the crc32 instruction.
+  static bool hardware();
+
+private:
+  uint32_t crc;
+};
@@ -118,6 +118,60 @@ ink_rwlock_wrlock(ink_rwlock *rw)
   return 0;
 }
 
+//-------------------------------------------------------------------------
+// ink_rwlock_tryrdlock
+//
+// Returns EBUSY instead of waiting if a writer holds or waits for the lock.
+//-------------------------------------------------------------------------
+
+int
+ink_rwlock_tryrdlock(ink_rwlock *rw)
+{
+  int result = 0;
+
+  if (rw->rw_magic != RW_MAGIC) {
+    return EINVAL;
+  }
+
+  ink_mutex_acquire(&rw->rw_mutex);
+
+  if (rw->rw_refcount < 0 || rw->rw_nwaitwriters > 0) {
+    result = EBUSY; /* held by a writer or waiting writers */
+  } else {
+    rw->rw_refcount++; /* increment count of reader locks */
+  }
+
+  ink_mutex_release(&rw->rw_mutex);
+
+  return result;
+}
+
+//-------------------------------------------------------------------------
+// ink_rwlock_trywrlock
+//-------------------------------------------------------------------------
+
+int
+ink_rwlock_trywrlock(ink_rwlock *rw)
+{
+  int result = 0;
+
+  if (rw->rw_magic != RW_MAGIC) {
+    return EINVAL;
+  }
+
+  ink_mutex_acquire(&rw->rw_mutex);
+
+  if (rw->rw_refcount != 0) {
+    result = EBUSY; /* held by either writer or reader(s) */
+  } else {
+    rw->rw_refcount = -1; /* available, indicate a writer has it */
+  }
+
+  ink_mutex_release(&rw->rw_mutex);
+
+  return result;
+}
+
 //-------------------------------------------------------------------------
 // ink_rwlock_unlock
 //-------------------------------------------------------------------------
@@ -48,4 +48,6 @@ int ink_rwlock_init(ink_rwlock *rw);
 int ink_rwlock_destroy(ink_rwlock *rw);
 int ink_rwlock_rdlock(ink_rwlock *rw);
 int ink_rwlock_wrlock(ink_rwlock *rw);
+int ink_rwlock_tryrdlock(ink_rwlock *rw);
+int ink_rwlock_trywrlock(ink_rwlock *rw);
 int ink_rwlock_unlock(ink_rwlock *rw);
@@ -0,0 +1,207 @@
+/** @file
+
+  Test code for the consistent hash rings.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ts/ConsistentHash.h"
+#include "ts/HashSip.h"
+#include <catch.hpp>
+
+namespace
+{
+struct TestNode : ATSConsistentHashNode {
+  char buf[32];
+
+  TestNode(int i)
+  {
+    snprintf(buf, sizeof(buf), "parent%d.example.com", i);
+    name      = buf;
+    available = true;
+  }
+};
+
+void
+fill(std::vector<TestNode *> &parents, ATSConsistentHash &map_ring, ATSFlatConsistentHash &flat_ring, int count)
+{
+  ATSHash64Sip24 hash;
+
+  for (int i = 0; i < count; ++i) {
+    parents.push_back(new TestNode(i));
+    map_ring.insert(parents.back(), 1.0, &hash);
+    flat_ring.insert(parents.back(), 1.0, &hash);
+  }
+  flat_ring.finalize();
+}
+} // namespace
+
+TEST_CASE("ConsistentHashRing", "[libts][ConsistentHash]")
+{
+  std::vector<TestNode *> parents;
+  ATSConsistentHash map_ring;
+  ATSFlatConsistentHash flat_ring;
+  ATSHash64Sip24 hash;
+  std::mt19937_64 rng(42);
+
+  fill(parents, map_ring, flat_ring, 16);
+  REQUIRE(flat_ring.size() == 16 * 1024);
+
+  SECTION("lookups match the map ring")
+  {
+    for (int i = 0; i < 10000; ++i) {
+      uint64_t hashval = rng();
+      ATSConsistentHashIter map_iter;
+      ATSFlatConsistentHashIter flat_iter;
+      bool map_wrap = false, flat_wrap = false;
+
+      REQUIRE(map_ring.lookup_by_hashval(hashval, &map_iter, &map_wrap) ==
+              flat_ring.lookup_by_hashval(hashval, &flat_iter, &flat_wrap));
+      REQUIRE(map_wrap == flat_wrap);
+      // walk a few points forward
+      for (int j = 0; j < 8; ++j) {
+        ATSConsistentHashNode *node = flat_ring.lookup(nullptr, &flat_iter, &flat_wrap, &hash);
+        REQUIRE(node != nullptr);
+        REQUIRE(node == map_ring.lookup(nullptr, &map_iter, &map_wrap, &hash));
+      }
+    }
+  }
+
+  SECTION("wrap around")
+  {
+    ATSFlatConsistentHashIter iter;
+    bool wrapped = false;
+
+    REQUIRE(flat_ring.lookup_by_hashval(UINT64_MAX, &iter, &wrapped) != nullptr);
+    CHECK(wrapped == true);
+    CHECK(iter == 0);
+
+    wrapped = false;
+    flat_ring.lookup_by_hashval(0, &iter, &wrapped);
+    size_t count = 1;
+    while (flat_ring.lookup(nullptr, &iter, &wrapped, &hash) != nullptr) {
+      ++count;
+    }
+    // the end of the ring is reached once to wrap, the second time ends the walk
+    CHECK(count == 2 * flat_ring.size());
+  }
+
+  SECTION("next node skips the replicas of the current node")
+  {
+    for (int i = 0; i < 1000; ++i) {
+      uint64_t hashval = rng();
+      ATSConsistentHashIter map_iter;
+      ATSFlatConsistentHashIter iter;
+      bool map_wrap = false, wrapped = false;
+      ATSConsistentHashNode *first = flat_ring.lookup_by_hashval(hashval, &iter, &wrapped);
+      ATSConsistentHashNode *next  = flat_ring.lookup_next_node(&iter, &wrapped);
+      REQUIRE(next != nullptr);
+      REQUIRE(next != first);
+      map_ring.lookup_by_hashval(hashval, &map_iter, &map_wrap);
+      REQUIRE(next == map_ring.lookup_next_node(&map_iter, &map_wrap));
+      REQUIRE(wrapped == map_wrap);
+    }
+  }
+
+  SECTION("available lookups match the map ring")
+  {
+    for (int i = 0; i < 16; i += 3) {
+      parents[i]->available = false;
+    }
+    for (int i = 0; i < 10000; ++i) {
+      char url[64];
+
+      snprintf(url, sizeof(url), "/path/%d", i);
+      ATSConsistentHashNode *node = flat_ring.lookup_available(url, nullptr, nullptr, &hash);
+      REQUIRE(node != nullptr);
+      REQUIRE(node->available);
+      REQUIRE(node == map_ring.lookup_available(url, nullptr, nullptr, &hash));
+    }
+
+    for (auto parent : parents) {
+      parent->available = false;
+    }
+    CHECK(flat_ring.lookup_available("/path", nullptr, nullptr, &hash) == nullptr);
+  }
+
+  for (auto parent : parents) {
+    delete parent;
+  }
+}
+
+// Run with: test_tslib "[bench]"
+TEST_CASE("ConsistentHashRing benchmark", "[libts][ConsistentHash][.][bench]")
+{
+  std::vector<TestNode *> parents;
+  ATSConsistentHash map_ring;
+  ATSFlatConsistentHash flat_ring;
+  std::mt19937_64 rng(42);
+  ATSHash64Sip24 hash;
+  std::vector<uint64_t> hashvals(1000000);
+  uintptr_t sink = 0;
+
+  fill(parents, map_ring, flat_ring, 64);
+  for (auto &hashval : hashvals) {
+    hashval = rng();
+  }
+  // a quarter of the parents are down
+  for (size_t i = 0; i < parents.size(); i += 4) {
+    parents[i]->available = false;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (auto hashval : hashvals) {
+    ATSConsistentHashIter iter;
+    bool wrapped                = false;
+    ATSConsistentHashNode *node = map_ring.lookup_by_hashval(hashval, &iter, &wrapped);
+    while (node && !node->available) {
+      node = map_ring.lookup(nullptr, &iter, &wrapped, &hash);
+    }
+    sink += reinterpret_cast<uintptr_t>(node);
+  }
+  auto map_time = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (auto hashval : hashvals) {
+    ATSFlatConsistentHashIter iter;
+    bool wrapped                = false;
+    ATSConsistentHashNode *node = flat_ring.lookup_by_hashval(hashval, &iter, &wrapped);
+    while (node && !node->available) {
+      node = flat_ring.lookup_next_node(&iter, &wrapped);
+    }
+    sink -= reinterpret_cast<uintptr_t>(node);
+  }
+  auto flat_time = std::chrono::steady_clock::now() - start;
+
+  // both rings must have picked the same parents
+  CHECK(sink == 0);
+  std::cout << hashvals.size() << " lookups over " << flat_ring.size() << " points: std::map ring "
+            << std::chrono::duration_cast<std::chrono::microseconds>(map_time).count() << " usec, flat ring "
+            << std::chrono::duration_cast<std::chrono::microseconds>(flat_time).count() << " usec" << std::endl;
+
+  for (auto parent : parents) {
+    delete parent;
+  }
+}
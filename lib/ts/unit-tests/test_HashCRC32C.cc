@@ -0,0 +1,106 @@
+/** @file
+
+  Test code for the CRC-32C hash.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <cstring>
+#include <vector>
+
+#include "ts/HashCRC32C.h"
+#include <catch.hpp>
+
+namespace
+{
+uint32_t
+crc32c(const void *data, size_t len)
+{
+  ATSHash32CRC32C hash;
+
+  hash.update(data, len);
+  hash.final();
+  return hash.get();
+}
+
+// bit at a time, straight from the definition
+uint32_t
+crc32c_reference(const uint8_t *p, size_t len)
+{
+  uint32_t crc = 0xffffffff;
+
+  while (len--) {
+    crc ^= *p++;
+    for (int k = 0; k < 8; ++k) {
+      crc = (crc >> 1) ^ (0x82f63b78 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+} // namespace
+
+TEST_CASE("CRC32C", "[libts][HashCRC32C]")
+{
+  INFO("crc32 instruction: " << ATSHash32CRC32C::hardware());
+
+  SECTION("check values")
+  {
+    CHECK(crc32c("", 0) == 0);
+    CHECK(crc32c("123456789", 9) == 0xe3069283);
+
+    // RFC 3720 B.4
+    std::vector<uint8_t> buf(32, 0);
+    CHECK(crc32c(buf.data(), buf.size()) == 0x8a9136aa);
+    memset(buf.data(), 0xff, buf.size());
+    CHECK(crc32c(buf.data(), buf.size()) == 0x62a8ab43);
+    for (size_t i = 0; i < buf.size(); ++i) {
+      buf[i] = i;
+    }
+    CHECK(crc32c(buf.data(), buf.size()) == 0x46dd794e);
+  }
+
+  SECTION("lengths and alignments match the reference")
+  {
+    std::vector<uint8_t> buf(1024 + 8);
+    for (size_t i = 0; i < buf.size(); ++i) {
+      buf[i] = i * 131 + 7;
+    }
+    for (size_t offset = 0; offset < 8; ++offset) {
+      for (size_t len = 0; len <= 64; ++len) {
+        REQUIRE(crc32c(buf.data() + offset, len) == crc32c_reference(buf.data() + offset, len));
+      }
+      REQUIRE(crc32c(buf.data() + offset, 1024) == crc32c_reference(buf.data() + offset, 1024));
+    }
+  }
+
+  SECTION("updates in pieces")
+  {
+    const char *text = "The quick brown fox jumps over the lazy dog";
+    size_t len       = strlen(text);
+    ATSHash32CRC32C hash;
+
+    for (size_t split = 0; split <= len; ++split) {
+      hash.clear();
+      hash.update(text, split);
+      hash.update(text + split, len - split);
+      hash.final();
+      REQUIRE(hash.get() == crc32c(text, len));
+    }
+  }
+}
@@ -1031,6 +1031,15 @@ LocalManager::bindProxyPort(HttpProxyPort &port)
     mgmt_fatal(0, "[bindProxyPort] Unable to set socket options: %d : %s\n", port.m_port, strerror(errno));
   }
 
+#ifdef SO_REUSEPORT
+  // The per thread listen sockets of traffic_server join this socket's group, so it must be set before bind.
+  bool found;
+  RecInt reuseport = REC_readInteger("proxy.config.net.listen_reuseport", &found);
+  if (found && reuseport > 0 && setsockopt(port.m_fd, SOL_SOCKET, SO_REUSEPORT, (char *)&one, sizeof(int)) < 0) {
+    mgmt_log("[bindProxyPort] Unable to set SO_REUSEPORT: %d : %s\n", port.m_port, strerror(errno));
+  }
+#endif
+
   if (port.m_inbound_transparent_p) {
 #if TS_USE_TPROXY
     Debug("http_tproxy", "Listen port %d inbound transparency enabled.", port.m_port);
@@ -23,7 +23,19 @@
 #include "HostStatus.h"
 #include "ParentConsistentHash.h"
 
-ParentConsistentHash::ParentConsistentHash(ParentRecord *parent_record)
+template <> ATSConsistentHashIter *
+ParentConsistentHash::getIter(ParentResult *result, int lookup)
+{
+  return &result->chashIter[lookup];
+}
+
+template <> ATSFlatConsistentHashIter *
+ParentFlatConsistentHash::getIter(ParentResult *result, int lookup)
+{
+  return &result->chashFlatIter[lookup];
+}
+
+template <class CHash> ParentConsistentHashBase<CHash>::ParentConsistentHashBase(ParentRecord *parent_record)
 {
   int i;
 
@@ -33,35 +45,38 @@ ParentConsistentHash::ParentConsistentHash(ParentRecord *parent_record)
   ignore_query       = parent_record->ignore_query;
   ink_zero(foundParents);
 
-  chash[PRIMARY] = new ATSConsistentHash();
+  chash[PRIMARY] = new CHash();
 
   for (i = 0; i < parent_record->num_parents; i++) {
     chash[PRIMARY]->insert(&(parent_record->parents[i]), parent_record->parents[i].weight, (ATSHash64 *)&hash[PRIMARY]);
   }
+  chash[PRIMARY]->finalize();
 
   if (parent_record->num_secondary_parents > 0) {
     Debug("parent_select", "ParentConsistentHash(): initializing the secondary parents hash.");
-    chash[SECONDARY] = new ATSConsistentHash();
+    chash[SECONDARY] = new CHash();
 
     for (i = 0; i < parent_record->num_secondary_parents; i++) {
       chash[SECONDARY]->insert(&(parent_record->secondary_parents[i]), parent_record->secondary_parents[i].weight,
                                (ATSHash64 *)&hash[SECONDARY]);
     }
+    chash[SECONDARY]->finalize();
   } else {
     chash[SECONDARY] = nullptr;
   }
   Debug("parent_select", "Using a consistent hash parent selection strategy.");
 }
 
-ParentConsistentHash::~ParentConsistentHash()
+template <class CHash> ParentConsistentHashBase<CHash>::~ParentConsistentHashBase()
 {
   Debug("parent_select", "~ParentConsistentHash(): releasing hashes");
   delete chash[PRIMARY];
   delete chash[SECONDARY];
 }
 
+template <class CHash>
 uint64_t
-ParentConsistentHash::getPathHash(HttpRequestData *hrdata, ATSHash64 *h)
+ParentConsistentHashBase<CHash>::getPathHash(HttpRequestData *hrdata, ATSHash64 *h)
 {
   const char *url_string_ref = nullptr;
   int len;
@@ -104,12 +119,13 @@ ParentConsistentHash::getPathHash(HttpRequestData *hrdata, ATSHash64 *h)
   return h->get();
 }
 
+template <class CHash>
 void
-ParentConsistentHash::selectParent(bool first_call, ParentResult *result, RequestData *rdata, unsigned int fail_threshold,
-                                   unsigned int retry_time)
+ParentConsistentHashBase<CHash>::selectParent(bool first_call, ParentResult *result, RequestData *rdata,
+                                              unsigned int fail_threshold, unsigned int retry_time)
 {
   ATSHash64Sip24 hash;
-  ATSConsistentHash *fhash;
+  CHash *fhash;
   HttpRequestData *request_info = static_cast<HttpRequestData *>(rdata);
   bool firstCall                = first_call;
   bool parentRetry              = false;
@@ -141,7 +157,7 @@ ParentConsistentHash::selectParent(bool first_call, ParentResult *result, Reques
     path_hash   = getPathHash(request_info, (ATSHash64 *)&hash);
     fhash       = chash[PRIMARY];
     if (path_hash) {
-      prtmp = (pRecord *)fhash->lookup_by_hashval(path_hash, &result->chashIter[last_lookup], &wrap_around[last_lookup]);
+      prtmp = (pRecord *)fhash->lookup_by_hashval(path_hash, getIter(result, last_lookup), &wrap_around[last_lookup]);
       if (prtmp) {
         pRec = (parents[last_lookup] + prtmp->idx);
       }
@@ -152,7 +168,7 @@ ParentConsistentHash::selectParent(bool first_call, ParentResult *result, Reques
       last_lookup = SECONDARY;
       fhash       = chash[SECONDARY];
       path_hash   = getPathHash(request_info, (ATSHash64 *)&hash);
-      prtmp       = (pRecord *)fhash->lookup_by_hashval(path_hash, &result->chashIter[last_lookup], &wrap_around[last_lookup]);
+      prtmp       = (pRecord *)fhash->lookup_by_hashval(path_hash, getIter(result, last_lookup), &wrap_around[last_lookup]);
       if (prtmp) {
         pRec = (parents[last_lookup] + prtmp->idx);
       }
@@ -160,7 +176,7 @@ ParentConsistentHash::selectParent(bool first_call, ParentResult *result, Reques
       last_lookup = PRIMARY;
       fhash       = chash[PRIMARY];
       do { // search until we've selected a different parent.
-        prtmp = (pRecord *)fhash->lookup(nullptr, &result->chashIter[last_lookup], &wrap_around[last_lookup], &hash);
+        prtmp = (pRecord *)fhash->lookup_next_node(getIter(result, last_lookup), &wrap_around[last_lookup]);
         if (prtmp) {
           pRec = (parents[last_lookup] + prtmp->idx);
         } else {
@@ -200,10 +216,11 @@ ParentConsistentHash::selectParent(bool first_call, ParentResult *result, Reques
           last_lookup = PRIMARY;
         }
         if (firstCall) {
-          prtmp     = (pRecord *)fhash->lookup_by_hashval(path_hash, &result->chashIter[last_lookup], &wrap_around[last_lookup]);
+          prtmp     = (pRecord *)fhash->lookup_by_hashval(path_hash, getIter(result, last_lookup), &wrap_around[last_lookup]);
           firstCall = false;
         } else {
-          prtmp = (pRecord *)fhash->lookup(nullptr, &result->chashIter[last_lookup], &wrap_around[last_lookup], &hash);
+          // Skip the remaining replicas of the parent that was just rejected in one step.
+          prtmp = (pRecord *)fhash->lookup_next_node(getIter(result, last_lookup), &wrap_around[last_lookup]);
         }
 
         if (prtmp) {
@@ -251,8 +268,9 @@ ParentConsistentHash::selectParent(bool first_call, ParentResult *result, Reques
   return;
 }
 
+template <class CHash>
 uint32_t
-ParentConsistentHash::numParents(ParentResult *result) const
+ParentConsistentHashBase<CHash>::numParents(ParentResult *result) const
 {
   uint32_t n = 0;
 
@@ -268,8 +286,9 @@ ParentConsistentHash::numParents(ParentResult *result) const
   return n;
 }
 
+template <class CHash>
 void
-ParentConsistentHash::markParentUp(ParentResult *result)
+ParentConsistentHashBase<CHash>::markParentUp(ParentResult *result)
 {
   pRecord *pRec;
 
@@ -299,3 +318,6 @@ ParentConsistentHash::markParentUp(ParentResult *result)
     Note("http parent proxy %s:%d restored", pRec->hostname, pRec->port);
   }
 }
+
+template class ParentConsistentHashBase<ATSConsistentHash>;
+template class ParentConsistentHashBase<ATSFlatConsistentHash>;
@@ -34,23 +34,26 @@
 
 //
 //  Implementation of round robin based upon consistent hash of the URL,
-//  ParentRR_t = P_CONSISTENT_HASH.
+//  ParentRR_t = P_CONSISTENT_HASH keeps the rings in a std::map and
+//  P_FLAT_CONSISTENT_HASH in sorted arrays. Both select the same parents.
 //
-class ParentConsistentHash : public ParentSelectionStrategy
+template <class CHash> class ParentConsistentHashBase : public ParentSelectionStrategy
 {
   // there are two hashes PRIMARY parents
   // and SECONDARY parents.
   ATSHash64Sip24 hash[2];
-  ATSConsistentHash *chash[2];
+  CHash *chash[2];
   pRecord *parents[2];
   bool foundParents[2][MAX_PARENTS];
   bool ignore_query;
 
+  typename CHash::Iter *getIter(ParentResult *result, int lookup);
+
 public:
   static const int PRIMARY   = 0;
   static const int SECONDARY = 1;
-  ParentConsistentHash(ParentRecord *_parent_record);
-  ~ParentConsistentHash() override;
+  ParentConsistentHashBase(ParentRecord *_parent_record);
+  ~ParentConsistentHashBase() override;
   pRecord *
   getParents(ParentResult *result) override
   {
@@ -63,3 +66,6 @@ public:
   uint32_t numParents(ParentResult *result) const override;
   void markParentUp(ParentResult *result);
 };
+
+typedef ParentConsistentHashBase<ATSConsistentHash> ParentConsistentHash;
+typedef ParentConsistentHashBase<ATSFlatConsistentHash> ParentFlatConsistentHash;
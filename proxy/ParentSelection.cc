@@ -616,6 +616,8 @@ ParentRecord::Init(matcher_line *line_info)
         round_robin = P_CONSISTENT_HASH;
       } else if (strcasecmp(val, "latched") == 0) {
         round_robin = P_LATCHED_ROUND_ROBIN;
+      } else if (strcasecmp(val, "flat_consistent_hash") == 0) {
+        round_robin = P_FLAT_CONSISTENT_HASH;
       } else {
         round_robin = P_NO_ROUND_ROBIN;
         errPtr      = "invalid argument to round_robin directive";
@@ -752,6 +754,10 @@ ParentRecord::Init(matcher_line *line_info)
     Debug("parent_select", "allocating ParentConsistentHash() lookup strategy.");
     selection_strategy = new ParentConsistentHash(this);
     break;
+  case P_FLAT_CONSISTENT_HASH:
+    Debug("parent_select", "allocating ParentFlatConsistentHash() lookup strategy.");
+    selection_strategy = new ParentFlatConsistentHash(this);
+    break;
   default:
     ink_release_assert(0);
   }
@@ -1553,6 +1559,59 @@ EXCLUSIVE_REGRESSION_TEST(PARENTSELECTION)(RegressionTest * /* t ATS_UNUSED */,
   FP;
   RE(verify(result, PARENT_SPECIFIED, "fuzzy", 80), 194);
 
+  // Test 195
+  // the flat consistent hash ring has the same points as consistent_hash,
+  // so the parents are chosen in the same order as tests 173 - 177.
+  tbl[0] = '\0';
+  ST(195);
+  T("dest_domain=rabbit.net parent=fuzzy:80|1.0;fluffy:80|1.0 secondary_parent=furry:80|1.0;frisky:80|1.0 "
+    "round_robin=flat_consistent_hash go_direct=false\n");
+  REBUILD;
+  REINIT;
+  br(request, "i.am.rabbit.net");
+  FP;
+  sleep(1);
+  RE(verify(result, PARENT_SPECIFIED, "fuzzy", 80), 195);
+  params->markParentDown(result, fail_threshold, retry_time); // fuzzy is down.
+
+  // Test 196
+  ST(196);
+  REINIT;
+  br(request, "i.am.rabbit.net");
+  FP;
+  sleep(1);
+  RE(verify(result, PARENT_SPECIFIED, "frisky", 80), 196);
+
+  params->markParentDown(result, fail_threshold, retry_time); // frisky is down.
+
+  // Test 197
+  ST(197);
+  REINIT;
+  br(request, "i.am.rabbit.net");
+  FP;
+  sleep(1);
+  RE(verify(result, PARENT_SPECIFIED, "furry", 80), 197);
+
+  params->markParentDown(result, fail_threshold, retry_time); // furry is down.
+
+  // Test 198
+  ST(198);
+  REINIT;
+  br(request, "i.am.rabbit.net");
+  FP;
+  sleep(1);
+  RE(verify(result, PARENT_SPECIFIED, "fluffy", 80), 198);
+
+  params->markParentDown(result, fail_threshold, retry_time); // all are down now.
+
+  // Test 199
+  ST(199);
+  REINIT;
+  br(request, "i.am.rabbit.net");
+  FP;
+  sleep(1);
+  RE(verify(result, PARENT_FAIL, nullptr, 80), 199);
+
   delete request;
   delete result;
   delete params;
@@ -65,6 +65,7 @@ enum ParentRR_t {
   P_HASH_ROUND_ROBIN,
   P_CONSISTENT_HASH,
   P_LATCHED_ROUND_ROBIN,
+  P_FLAT_CONSISTENT_HASH,
 };
 
 enum ParentRetry_t {
@@ -254,8 +255,9 @@ private:
   // state for consistent hash.
   int last_lookup;
   ATSConsistentHashIter chashIter[2];
+  ATSFlatConsistentHashIter chashFlatIter[2];
 
-  friend class ParentConsistentHash;
+  template <class CHash> friend class ParentConsistentHashBase;
   friend class ParentRoundRobin;
   friend class ParentConfigParams;
   friend class ParentRecord;
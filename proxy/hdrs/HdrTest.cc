@@ -76,6 +76,7 @@ HdrTest::go(RegressionTest *t, int /* atype ATS_UNUSED */)
   status = status & test_arena();
   status = status & test_regex();
   status = status & test_http_parser_eos_boundary_cases();
+  status = status & test_http_parser_scan_boundaries();
   status = status & test_http_mutation();
   status = status & test_mime();
   status = status & test_http();
@@ -708,6 +709,74 @@ HdrTest::test_http_parser_eos_boundary_cases()
   return (failures_to_status("test_http_parser_eos_boundary_cases", failures));
 }
 
+/*-------------------------------------------------------------------------
+  -------------------------------------------------------------------------*/
+
+int
+HdrTest::test_http_parser_scan_boundaries()
+{
+  // The header scanner works on 16 and 32 byte blocks, move the line ends and nul characters
+  // across the block boundaries.
+  static const char prefix[] = "GET /index.html HTTP/1.1\r\nHost: example.com\r\nX-Pad: ";
+  static const char suffix[] = "\r\nAccept: */*\r\n\r\n";
+  char buf[256];
+  int failures = 0;
+
+  bri_box("test_http_parser_scan_boundaries");
+
+  for (int value_len = 0; value_len < 80; ++value_len) {
+    int prefix_len = sizeof(prefix) - 1;
+    int len        = prefix_len;
+
+    memcpy(buf, prefix, prefix_len);
+    memset(buf + len, 'a', value_len);
+    len += value_len;
+    memcpy(buf + len, suffix, sizeof(suffix) - 1);
+    len += sizeof(suffix) - 1;
+
+    // nul_at < 0 is the clean header, otherwise a nul replaces that byte of the X-Pad value.
+    for (int nul_at = -1; nul_at < value_len; ++nul_at) {
+      HTTPHdr req_hdr;
+      HTTPParser parser;
+      char copy[256];
+      const char *start = copy;
+      const char *end   = copy + len;
+
+      memcpy(copy, buf, len);
+      if (nul_at >= 0) {
+        copy[prefix_len + nul_at] = '\0';
+      }
+
+      req_hdr.create(HTTP_TYPE_REQUEST);
+      http_parser_init(&parser);
+      ParseResult ret = req_hdr.parse_req(&parser, &start, end, true);
+
+      if (nul_at >= 0) {
+        if (ret != PARSE_RESULT_ERROR) {
+          ++failures;
+          printf("FAILED: value length %d, nul at %d: expected parse error, got %d\n", value_len, nul_at, ret);
+        }
+      } else {
+        MIMEField *field = req_hdr.field_find("X-Pad", 5);
+        int field_len    = -1;
+        if (field) {
+          field->value_get(&field_len);
+        }
+        if (ret != PARSE_RESULT_DONE || start != end || field_len != value_len || req_hdr.field_find("Accept", 6) == nullptr) {
+          ++failures;
+          printf("FAILED: value length %d: retval %d, eaten %d of %d, value length %d\n", value_len, ret,
+                 static_cast<int>(start - copy), len, field_len);
+        }
+      }
+
+      http_parser_clear(&parser);
+      req_hdr.destroy();
+    }
+  }
+
+  return (failures_to_status("test_http_parser_scan_boundaries", failures));
+}
+
 /*-------------------------------------------------------------------------
   -------------------------------------------------------------------------*/
 
@@ -28,6 +28,11 @@
 #include <cassert>
 #include <cstdio>
 #include <cstring>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 #include "MIME.h"
 #include "HdrHeap.h"
 #include "HdrToken.h"
@@ -2372,6 +2377,45 @@ mime_scanner_append(MIMEScanner *scanner, const char *data, int data_size)
   scanner->m_line_length += data_size;
 }
 
+/** Find the first LF or nul in [@a s, @a e), returns @a e if there is neither.
+
+    This is the inner loop of the header scanner. The LF ends a line and a nul anywhere in a header
+    is an error, looking for both in one pass saves scanning the header again for nul characters.
+    The widest vector unit enabled at build time is used, SSE2 is always there on x86_64.
+*/
+static inline const char *
+mime_scan_lf_or_nul(const char *s, const char *e)
+{
+#if defined(__AVX2__)
+  const __m256i lf32  = _mm256_set1_epi8(ParseRules::CHAR_LF);
+  const __m256i nul32 = _mm256_setzero_si256();
+  for (; e - s >= 32; s += 32) {
+    __m256i v     = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s));
+    uint32_t mask = _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, lf32), _mm256_cmpeq_epi8(v, nul32)));
+    if (mask) {
+      return s + __builtin_ctz(mask);
+    }
+  }
+#endif
+#if defined(__SSE2__)
+  const __m128i lf16  = _mm_set1_epi8(ParseRules::CHAR_LF);
+  const __m128i nul16 = _mm_setzero_si128();
+  for (; e - s >= 16; s += 16) {
+    __m128i v     = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s));
+    uint32_t mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, lf16), _mm_cmpeq_epi8(v, nul16)));
+    if (mask) {
+      return s + __builtin_ctz(mask);
+    }
+  }
+#endif
+  for (; s < e; ++s) {
+    if (*s == ParseRules::CHAR_LF || *s == '\0') {
+      return s;
+    }
+  }
+  return e;
+}
+
 ParseResult
 mime_scanner_get(MIMEScanner *S, const char **raw_input_s, const char *raw_input_e, const char **output_s, const char **output_e,
                  bool *output_shares_raw_input,
@@ -2380,6 +2424,7 @@ mime_scanner_get(MIMEScanner *S, const char **raw_input_s, const char *raw_input
 {
   const char *raw_input_c, *lf_ptr;
   ParseResult zret = PARSE_RESULT_CONT;
+  bool saw_nul     = false;
   // Need this for handling dangling CR.
   static const char RAW_CR = ParseRules::CHAR_CR;
 
@@ -2425,8 +2470,13 @@ mime_scanner_get(MIMEScanner *S, const char **raw_input_s, const char *raw_input
       }
       break;
     case MIME_PARSE_INSIDE:
-      lf_ptr = static_cast<const char *>(memchr(raw_input_c, ParseRules::CHAR_LF, runway));
-      if (lf_ptr) {
+      // Every byte consumed outside of this state is a CR or LF, so this is the only place a nul can be.
+      lf_ptr = mime_scan_lf_or_nul(raw_input_c, raw_input_e);
+      while (lf_ptr < raw_input_e && *lf_ptr == '\0') {
+        saw_nul = true;
+        lf_ptr  = mime_scan_lf_or_nul(lf_ptr + 1, raw_input_e);
+      }
+      if (lf_ptr < raw_input_e) {
         raw_input_c = lf_ptr + 1;
         if (MIME_SCANNER_TYPE_LINE == raw_input_scan_type) {
           zret       = PARSE_RESULT_OK;
@@ -2517,7 +2567,7 @@ mime_scanner_get(MIMEScanner *S, const char **raw_input_s, const char *raw_input
   }
 
   // Make sure there are no '\0' in the input scanned so far
-  if (zret != PARSE_RESULT_ERROR && memchr(*raw_input_s, '\0', raw_input_c - *raw_input_s) != nullptr) {
+  if (zret != PARSE_RESULT_ERROR && saw_nul) {
     zret = PARSE_RESULT_ERROR;
   }
 
@@ -115,7 +115,8 @@ static const ConfigEnumPair<TSServerSessionSharingMatchType> SessionSharingMatch
 
 static const ConfigEnumPair<TSServerSessionSharingPoolType> SessionSharingPoolStrings[] = {
   {TS_SERVER_SESSION_SHARING_POOL_GLOBAL, "global"},
-  {TS_SERVER_SESSION_SHARING_POOL_THREAD, "thread"}};
+  {TS_SERVER_SESSION_SHARING_POOL_THREAD, "thread"},
+  {TS_SERVER_SESSION_SHARING_POOL_HYBRID, "hybrid"}};
 
 int HttpConfig::m_id = 0;
 HttpConfigParams HttpConfig::m_master;
@@ -855,6 +856,16 @@ register_stat_callbacks()
                      (int)https_total_client_connections_stat, RecRawStatSyncCount);
   RecRegisterRawStat(http_rsb, RECT_PROCESS, "proxy.process.http.origin_connections_throttled_out", RECD_COUNTER, RECP_PERSISTENT,
                      (int)http_origin_connections_throttled_stat, RecRawStatSyncCount);
+  RecRegisterRawStat(http_rsb, RECT_PROCESS, "proxy.process.http.origin_session_pool.hits", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)http_origin_session_pool_hits_stat, RecRawStatSyncCount);
+  RecRegisterRawStat(http_rsb, RECT_PROCESS, "proxy.process.http.origin_session_pool.misses", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)http_origin_session_pool_misses_stat, RecRawStatSyncCount);
+  RecRegisterRawStat(http_rsb, RECT_PROCESS, "proxy.process.http.origin_session_pool.lock_contention", RECD_COUNTER,
+                     RECP_PERSISTENT, (int)http_origin_session_pool_lock_contention_stat, RecRawStatSyncCount);
+  RecRegisterRawStat(http_rsb, RECT_PROCESS, "proxy.process.http.origin_session_pool.steals", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)http_origin_session_pool_steals_stat, RecRawStatSyncCount);
+  RecRegisterRawStat(http_rsb, RECT_PROCESS, "proxy.process.http.origin_session_pool.migrations", RECD_COUNTER, RECP_PERSISTENT,
+                     (int)http_origin_session_pool_migrations_stat, RecRawStatSyncCount);
   RecRegisterRawStat(http_rsb, RECT_PROCESS, "proxy.process.http.post_body_too_large", RECD_COUNTER, RECP_PERSISTENT,
                      (int)http_post_body_too_large, RecRawStatSyncCount);
   // milestones
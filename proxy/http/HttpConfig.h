@@ -321,6 +321,12 @@ enum {
 
   http_origin_connections_throttled_stat,
 
+  http_origin_session_pool_hits_stat,
+  http_origin_session_pool_misses_stat,
+  http_origin_session_pool_lock_contention_stat,
+  http_origin_session_pool_steals_stat,
+  http_origin_session_pool_migrations_stat,
+
   http_stat_count
 };
 
@@ -137,6 +137,13 @@ make_net_accept_options(const HttpProxyPort *port, unsigned nthreads)
   REC_ReadConfigInteger(net.tfo_queue_length, "proxy.config.net.sock_option_tfo_queue_size_in");
 #endif
 
+#ifdef SO_REUSEPORT
+  int reuseport = 0;
+  REC_ReadConfigInteger(reuseport, "proxy.config.net.listen_reuseport");
+  net.f_reuseport              = reuseport > 0;
+  net.f_reuseport_cpu_steering = reuseport > 1;
+#endif
+
   if (port) {
     net.f_inbound_transparent = port->m_inbound_transparent_p;
     net.ip_family             = port->m_family;
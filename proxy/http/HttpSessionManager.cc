@@ -310,15 +310,16 @@ HttpSessionManager::acquire_session(Continuation * /* cont ATS_UNUSED */, sockad
   // current thread and the original has been deleted. This should adequately cover TS-3266 so we
   // don't have to continue to hold the pool thread while we initialize the server session in the
   // client session
+  EThread *ethread = this_ethread();
+  TSServerSessionSharingPoolType pool_type =
+    static_cast<TSServerSessionSharingPoolType>(sm->t_state.http_config_param->server_session_sharing_pool);
   {
     // Now check to see if we have a connection in our shared connection pool
-    EThread *ethread       = this_ethread();
-    ProxyMutex *pool_mutex = (TS_SERVER_SESSION_SHARING_POOL_THREAD == sm->t_state.http_config_param->server_session_sharing_pool) ?
-                               ethread->server_session_pool->mutex.get() :
-                               m_g_pool->mutex.get();
+    ProxyMutex *pool_mutex =
+      (TS_SERVER_SESSION_SHARING_POOL_GLOBAL == pool_type) ? m_g_pool->mutex.get() : ethread->server_session_pool->mutex.get();
     MUTEX_TRY_LOCK(lock, pool_mutex, ethread);
     if (lock.is_locked()) {
-      if (TS_SERVER_SESSION_SHARING_POOL_THREAD == sm->t_state.http_config_param->server_session_sharing_pool) {
+      if (TS_SERVER_SESSION_SHARING_POOL_GLOBAL != pool_type) {
         retval = ethread->server_session_pool->acquireSession(ip, hostname_hash, match_style, sm, to_return);
         Debug("http_ss", "[acquire session] thread pool search %s", to_return ? "successful" : "failed");
       } else {
@@ -326,24 +327,11 @@ HttpSessionManager::acquire_session(Continuation * /* cont ATS_UNUSED */, sockad
         Debug("http_ss", "[acquire session] global pool search %s", to_return ? "successful" : "failed");
         // At this point to_return has been removed from the pool. Do we need to move it
         // to the same thread?
-        if (to_return) {
-          UnixNetVConnection *server_vc = dynamic_cast<UnixNetVConnection *>(to_return->get_netvc());
-          if (server_vc) {
-            UnixNetVConnection *new_vc = server_vc->migrateToCurrentThread(sm, ethread);
-            if (new_vc->thread != ethread) {
-              // Failed to migrate, put it back to global session pool
-              m_g_pool->releaseSession(to_return);
-              to_return = nullptr;
-              retval    = HSM_NOT_FOUND;
-            } else if (new_vc != server_vc) {
-              // The VC migrated, keep things from timing out on us
-              new_vc->set_inactivity_timeout(new_vc->get_inactivity_timeout());
-              to_return->set_netvc(new_vc);
-            } else {
-              // The VC moved, keep things from timing out on us
-              server_vc->set_inactivity_timeout(server_vc->get_inactivity_timeout());
-            }
-          }
+        if (to_return && !migrate_session(to_return, sm, ethread)) {
+          // Failed to migrate, put it back to global session pool
+          m_g_pool->releaseSession(to_return);
+          to_return = nullptr;
+          retval    = HSM_NOT_FOUND;
         }
       }
     } else { // Didn't get the lock.  to_return is still NULL
@@ -351,22 +339,96 @@ HttpSessionManager::acquire_session(Continuation * /* cont ATS_UNUSED */, sockad
     }
   }
 
+  // Nothing matched locally, see if another thread has an idle session to the origin. This is done
+  // after dropping the local pool lock so that two threads stealing from each other can't deadlock.
+  if (to_return == nullptr && retval != HSM_RETRY && TS_SERVER_SESSION_SHARING_POOL_HYBRID == pool_type) {
+    to_return = steal_session(ip, hostname_hash, match_style, sm, ethread);
+  }
+
   if (to_return) {
     Debug("http_ss", "[%" PRId64 "] [acquire session] return session from shared pool", to_return->con_id);
+    HTTP_INCREMENT_DYN_STAT(http_origin_session_pool_hits_stat);
     to_return->state = HSS_ACTIVE;
     // the attach_server_session will issue the do_io_read under the sm lock
     sm->attach_server_session(to_return);
     retval = HSM_DONE;
+  } else if (retval == HSM_RETRY) {
+    HTTP_INCREMENT_DYN_STAT(http_origin_session_pool_lock_contention_stat);
+  } else {
+    HTTP_INCREMENT_DYN_STAT(http_origin_session_pool_misses_stat);
   }
   return retval;
 }
 
+bool
+HttpSessionManager::migrate_session(HttpServerSession *ss, HttpSM *sm, EThread *ethread)
+{
+  UnixNetVConnection *server_vc = dynamic_cast<UnixNetVConnection *>(ss->get_netvc());
+  if (server_vc == nullptr) {
+    return true;
+  }
+
+  bool moved                 = server_vc->thread != ethread;
+  UnixNetVConnection *new_vc = server_vc->migrateToCurrentThread(sm, ethread);
+  if (new_vc->thread != ethread) {
+    return false;
+  } else if (new_vc != server_vc) {
+    // The VC migrated, keep things from timing out on us
+    new_vc->set_inactivity_timeout(new_vc->get_inactivity_timeout());
+    ss->set_netvc(new_vc);
+  } else {
+    // The VC moved, keep things from timing out on us
+    server_vc->set_inactivity_timeout(server_vc->get_inactivity_timeout());
+  }
+  if (moved) {
+    HTTP_INCREMENT_DYN_STAT(http_origin_session_pool_migrations_stat);
+  }
+  return true;
+}
+
+HttpServerSession *
+HttpSessionManager::steal_session(sockaddr const *ip, CryptoHash const &hostname_hash, TSServerSessionSharingMatchType match_style,
+                                  HttpSM *sm, EThread *ethread)
+{
+  EventProcessor::ThreadGroupDescriptor *tg = &eventProcessor.thread_group[ET_NET];
+  ServerSessionPool *local_pool             = ethread->server_session_pool;
+  unsigned int start                        = local_pool->steal_cursor++;
+
+  // Only try the locks, a busy pool is skipped rather than waited for.
+  for (int i = 0; i < tg->_count; ++i) {
+    EThread *t              = tg->_thread[(start + i) % tg->_count];
+    ServerSessionPool *pool = t->server_session_pool;
+    if (t == ethread || pool == nullptr) {
+      continue;
+    }
+
+    MUTEX_TRY_LOCK(lock, pool->mutex, ethread);
+    if (!lock.is_locked()) {
+      continue;
+    }
+
+    HttpServerSession *to_return = nullptr;
+    pool->acquireSession(ip, hostname_hash, match_style, sm, to_return);
+    if (to_return) {
+      if (migrate_session(to_return, sm, ethread)) {
+        Debug("http_ss", "[%" PRId64 "] [acquire session] stole session from thread %p", to_return->con_id, t);
+        HTTP_INCREMENT_DYN_STAT(http_origin_session_pool_steals_stat);
+        return to_return;
+      }
+      // The owning thread is busy with the NetVC, leave it there.
+      pool->releaseSession(to_return);
+      break;
+    }
+  }
+  return nullptr;
+}
+
 HSMresult_t
 HttpSessionManager::release_session(HttpServerSession *to_release)
 {
   EThread *ethread = this_ethread();
   ServerSessionPool *pool =
-    TS_SERVER_SESSION_SHARING_POOL_THREAD == to_release->sharing_pool ? ethread->server_session_pool : m_g_pool;
+    TS_SERVER_SESSION_SHARING_POOL_GLOBAL == to_release->sharing_pool ? m_g_pool : ethread->server_session_pool;
   bool released_p = true;
 
   // The per thread lock looks like it should not be needed but if it's not locked the close checking I/O op will crash.
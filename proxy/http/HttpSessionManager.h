@@ -144,6 +144,10 @@ public:
   // Note that each server session is stored in both pools.
   IPHashTable m_ip_pool;
   HostHashTable m_host_pool;
+
+  /// Thread to start from when stealing sessions from other threads.
+  /// @internal Only used by the thread owning the pool, not protected by the pool mutex.
+  unsigned int steal_cursor = 0;
 };
 
 class HttpSessionManager
@@ -159,6 +163,12 @@ public:
   int main_handler(int event, void *data);
 
 private:
+  /// Move the NetVC of @a ss to @a ethread, return @c false if it could not be moved.
+  bool migrate_session(HttpServerSession *ss, HttpSM *sm, EThread *ethread);
+  /// Take a matching session from the pool of another thread, for the hybrid pool.
+  HttpServerSession *steal_session(sockaddr const *ip, CryptoHash const &hostname_hash,
+                                   TSServerSessionSharingMatchType match_style, HttpSM *sm, EThread *ethread);
+
   /// Global pool, used if not per thread pools.
   /// @internal We delay creating this because the session manager is created during global statics init.
   ServerSessionPool *m_g_pool;
@@ -23,6 +23,7 @@
 
 #include "HPACK.h"
 #include "HuffmanCodec.h"
+#include "ts/HashFNV.h"
 
 // [RFC 7541] 4.1. Calculating Table Size
 // The size of an entry is the sum of its name's length in octets (as defined in Section 5.2),
@@ -166,6 +167,88 @@ static const StaticTable STATIC_TABLE[] = {{"", ""},
                                            {"via", ""},
                                            {"www-authenticate", ""}};
 
+static uint32_t
+hpack_name_hash32(const char *name, int name_len)
+{
+  ATSHash32FNV1a h;
+  h.update(name, name_len, ATSHash::nocase());
+  h.final();
+  return h.get();
+}
+
+static uint64_t
+hpack_name_hash(const char *name, int name_len)
+{
+  ATSHash64FNV1a h;
+  h.update(name, name_len, ATSHash::nocase());
+  h.final();
+  return h.get();
+}
+
+static uint64_t
+hpack_field_hash(const char *name, int name_len, const char *value, int value_len)
+{
+  ATSHash64FNV1a h;
+  h.update(name, name_len, ATSHash::nocase());
+  h.update(value, value_len);
+  h.final();
+  return h.get();
+}
+
+// Perfect hash of the names in the static table. The multiplier is searched for when the table is
+// built, so that every name has a slot of its own and finding a name takes one hash and compare.
+class StaticTableIndex
+{
+public:
+  StaticTableIndex()
+  {
+    uint32_t hashes[TS_HPACK_STATIC_TABLE_ENTRY_NUM];
+
+    for (int i = 1; i < TS_HPACK_STATIC_TABLE_ENTRY_NUM; ++i) {
+      hashes[i] = hpack_name_hash32(STATIC_TABLE[i].name, STATIC_TABLE[i].name_size);
+    }
+    for (bool perfect = false; !perfect; _multiplier += 2) {
+      memset(_first, 0, sizeof(_first));
+      perfect = true;
+      for (int i = 1; i < TS_HPACK_STATIC_TABLE_ENTRY_NUM && perfect; ++i) {
+        uint8_t &first = _first[_slot(hashes[i])];
+        if (!first) {
+          first = i;
+        } else {
+          // entries with the same name are next to each other, the slot keeps the first one
+          perfect = ptr_len_casecmp(STATIC_TABLE[i].name, STATIC_TABLE[i].name_size, STATIC_TABLE[first].name,
+                                    STATIC_TABLE[first].name_size) == 0;
+        }
+      }
+    }
+    _multiplier -= 2;
+  }
+
+  /// The first entry with @a name, 0 if there is none.
+  int
+  find(const char *name, int name_len) const
+  {
+    int index = _first[_slot(hpack_name_hash32(name, name_len))];
+
+    if (index && ptr_len_casecmp(name, name_len, STATIC_TABLE[index].name, STATIC_TABLE[index].name_size) == 0) {
+      return index;
+    }
+    return 0;
+  }
+
+private:
+  uint8_t
+  _slot(uint32_t hash) const
+  {
+    return (hash * _multiplier) >> 24;
+  }
+
+  uint32_t _multiplier = 0x9e3779b1;
+  uint8_t _first[256];
+};
+
+static const StaticTableIndex STATIC_TABLE_INDEX;
+
 /******************
  * Local functions
  ******************/
@@ -219,44 +302,29 @@ HpackLookupResult
 HpackIndexingTable::lookup(const char *name, int name_len, const char *value, int value_len) const
 {
   HpackLookupResult result;
-  const unsigned int entry_num = TS_HPACK_STATIC_TABLE_ENTRY_NUM + _dynamic_table->length();
-
-  for (unsigned int index = 1; index < entry_num; ++index) {
-    const char *table_name, *table_value;
-    int table_name_len = 0, table_value_len = 0;
-
-    if (index < TS_HPACK_STATIC_TABLE_ENTRY_NUM) {
-      // static table
-      table_name      = STATIC_TABLE[index].name;
-      table_value     = STATIC_TABLE[index].value;
-      table_name_len  = STATIC_TABLE[index].name_size;
-      table_value_len = STATIC_TABLE[index].value_size;
-    } else {
-      // dynamic table
-      const MIMEField *m_field = _dynamic_table->get_header_field(index - TS_HPACK_STATIC_TABLE_ENTRY_NUM);
 
-      table_name  = m_field->name_get(&table_name_len);
-      table_value = m_field->value_get(&table_value_len);
-    }
-
-    // Check whether name (and value) are matched
-    if (ptr_len_casecmp(name, name_len, table_name, table_name_len) == 0) {
-      if ((value_len == table_value_len) && (memcmp(value, table_value, value_len) == 0)) {
-        result.index      = index;
+  // An exact match is preferred to a match of the name only, and the static table to the dynamic one
+  int index = STATIC_TABLE_INDEX.find(name, name_len);
+  if (index) {
+    for (int i = index; i < TS_HPACK_STATIC_TABLE_ENTRY_NUM && strcmp(STATIC_TABLE[i].name, STATIC_TABLE[index].name) == 0; ++i) {
+      if (value_len == STATIC_TABLE[i].value_size && memcmp(value, STATIC_TABLE[i].value, value_len) == 0) {
+        result.index      = i;
+        result.index_type = HpackIndex::STATIC;
         result.match_type = HpackMatch::EXACT;
-        break;
-      } else if (!result.index) {
-        result.index      = index;
-        result.match_type = HpackMatch::NAME;
+        return result;
       }
     }
   }
-  if (result.match_type != HpackMatch::NONE) {
-    if (result.index < TS_HPACK_STATIC_TABLE_ENTRY_NUM) {
-      result.index_type = HpackIndex::STATIC;
-    } else {
-      result.index_type = HpackIndex::DYNAMIC;
-    }
+
+  HpackLookupResult dynamic = _dynamic_table->lookup(name, name_len, value, value_len);
+  if (dynamic.match_type == HpackMatch::EXACT || (!index && dynamic.match_type == HpackMatch::NAME)) {
+    result.index      = TS_HPACK_STATIC_TABLE_ENTRY_NUM + dynamic.index;
+    result.index_type = HpackIndex::DYNAMIC;
+    result.match_type = dynamic.match_type;
+  } else if (index) {
+    result.index      = index;
+    result.index_type = HpackIndex::STATIC;
+    result.match_type = HpackMatch::NAME;
   }
 
   return result;
@@ -321,7 +389,80 @@ HpackIndexingTable::update_maximum_size(uint32_t new_size)
 const MIMEField *
 HpackDynamicTable::get_header_field(uint32_t index) const
 {
-  return _headers.at(index);
+  ink_assert(index < _length);
+  return _entry(_inserted - 1 - index);
+}
+
+HpackLookupResult
+HpackDynamicTable::lookup(const char *name, int name_len, const char *value, int value_len) const
+{
+  HpackLookupResult result;
+  uint64_t newest = 0;
+
+  // When there are several, the newest entry has the lowest index
+  auto exact = _field_index.equal_range(hpack_field_hash(name, name_len, value, value_len));
+  for (auto spot = exact.first; spot != exact.second; ++spot) {
+    int table_name_len, table_value_len;
+    const MIMEField *field  = _entry(spot->second);
+    const char *table_name  = field->name_get(&table_name_len);
+    const char *table_value = field->value_get(&table_value_len);
+
+    if ((result.match_type == HpackMatch::NONE || spot->second > newest) &&
+        ptr_len_casecmp(name, name_len, table_name, table_name_len) == 0 && value_len == table_value_len &&
+        memcmp(value, table_value, value_len) == 0) {
+      newest            = spot->second;
+      result.match_type = HpackMatch::EXACT;
+    }
+  }
+
+  if (result.match_type == HpackMatch::NONE) {
+    auto named = _name_index.equal_range(hpack_name_hash(name, name_len));
+    for (auto spot = named.first; spot != named.second; ++spot) {
+      int table_name_len;
+      const char *table_name = _entry(spot->second)->name_get(&table_name_len);
+
+      if ((result.match_type == HpackMatch::NONE || spot->second > newest) &&
+          ptr_len_casecmp(name, name_len, table_name, table_name_len) == 0) {
+        newest            = spot->second;
+        result.match_type = HpackMatch::NAME;
+      }
+    }
+  }
+
+  if (result.match_type != HpackMatch::NONE) {
+    result.index      = _inserted - 1 - newest;
+    result.index_type = HpackIndex::DYNAMIC;
+  }
+  return result;
+}
+
+static void
+hpack_index_erase(std::unordered_multimap<uint64_t, uint64_t> &index, uint64_t hash, uint64_t n)
+{
+  auto range = index.equal_range(hash);
+  for (auto spot = range.first; spot != range.second; ++spot) {
+    if (spot->second == n) {
+      index.erase(spot);
+      return;
+    }
+  }
+}
+
+// Remove the oldest entry
+void
+HpackDynamicTable::_evict()
+{
+  int name_len, value_len;
+  uint64_t n        = _inserted - _length;
+  MIMEField *field  = _entry(n);
+  const char *name  = field->name_get(&name_len);
+  const char *value = field->value_get(&value_len);
+
+  _current_size -= ADDITIONAL_OCTETS + name_len + value_len;
+  hpack_index_erase(_name_index, hpack_name_hash(name, name_len), n);
+  hpack_index_erase(_field_index, hpack_field_hash(name, name_len, value, value_len), n);
+  _mhdr->field_delete(field, false);
+  --_length;
 }
 
 void
@@ -337,28 +478,33 @@ HpackDynamicTable::add_header_field(const MIMEField *field)
     // It is not an error to attempt to add an entry that is larger than
     // the maximum size; an attempt to add an entry larger than the entire
     // table causes the table to be emptied of all existing entries.
-    _headers.clear();
+    _name_index.clear();
+    _field_index.clear();
     _mhdr->fields_clear();
+    _length       = 0;
     _current_size = 0;
   } else {
-    _current_size += header_size;
-    while (_current_size > _maximum_size) {
-      int last_name_len, last_value_len;
-      MIMEField *last_field = _headers.back();
-
-      last_field->name_get(&last_name_len);
-      last_field->value_get(&last_value_len);
-      _current_size -= ADDITIONAL_OCTETS + last_name_len + last_value_len;
+    while (_current_size + header_size > _maximum_size) {
+      _evict();
+    }
 
-      _headers.erase(_headers.begin() + _headers.size() - 1);
-      _mhdr->field_delete(last_field, false);
+    if (_length == _entries.size()) {
+      std::vector<MIMEField *> entries(std::max<size_t>(16, _entries.size() * 2));
+      for (uint64_t n = _inserted - _length; n < _inserted; ++n) {
+        entries[n & (entries.size() - 1)] = _entry(n);
+      }
+      _entries.swap(entries);
     }
 
     MIMEField *new_field = _mhdr->field_create(name, name_len);
     new_field->value_set(_mhdr->m_heap, _mhdr->m_mime, value, value_len);
     _mhdr->field_attach(new_field);
-    // XXX Because entire Vec instance is copied, Its too expensive!
-    _headers.insert(_headers.begin(), new_field);
+    _entries[_inserted & (_entries.size() - 1)] = new_field;
+    _name_index.emplace(hpack_name_hash(name, name_len), _inserted);
+    _field_index.emplace(hpack_field_hash(name, name_len, value, value_len), _inserted);
+    _current_size += header_size;
+    ++_inserted;
+    ++_length;
   }
 }
 
@@ -385,18 +531,10 @@ bool
 HpackDynamicTable::update_maximum_size(uint32_t new_size)
 {
   while (_current_size > new_size) {
-    if (_headers.size() <= 0) {
+    if (_length <= 0) {
       return false;
     }
-    int last_name_len, last_value_len;
-    MIMEField *last_field = _headers.back();
-
-    last_field->name_get(&last_name_len);
-    last_field->value_get(&last_value_len);
-    _current_size -= ADDITIONAL_OCTETS + last_name_len + last_value_len;
-
-    _headers.erase(_headers.begin() + _headers.size() - 1);
-    _mhdr->field_delete(last_field, false);
+    _evict();
   }
 
   _maximum_size = new_size;
@@ -406,7 +544,7 @@ HpackDynamicTable::update_maximum_size(uint32_t new_size)
 uint32_t
 HpackDynamicTable::length() const
 {
-  return _headers.size();
+  return _length;
 }
 
 //
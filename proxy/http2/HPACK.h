@@ -28,6 +28,7 @@
 #include "HTTP.h"
 
 #include <vector>
+#include <unordered_map>
 
 // It means that any header field can be compressed/decompressed by ATS
 const static int HPACK_ERROR_COMPRESSION_ERROR   = -1;
@@ -113,7 +114,6 @@ public:
 
   ~HpackDynamicTable()
   {
-    _headers.clear();
     _mhdr->fields_clear();
     _mhdr->destroy();
     delete _mhdr;
@@ -121,6 +121,7 @@ public:
 
   const MIMEField *get_header_field(uint32_t index) const;
   void add_header_field(const MIMEField *field);
+  HpackLookupResult lookup(const char *name, int name_len, const char *value, int value_len) const;
 
   uint32_t maximum_size() const;
   uint32_t size() const;
@@ -132,8 +133,22 @@ private:
   uint32_t _current_size;
   uint32_t _maximum_size;
 
+  MIMEField *
+  _entry(uint64_t n) const
+  {
+    return _entries[n & (_entries.size() - 1)];
+  }
+  void _evict();
+
   MIMEHdr *_mhdr;
-  std::vector<MIMEField *> _headers;
+  // The entries are numbered in the order they were added, entry n is at _entries[n % _entries.size()]
+  // and the newest one is at index 0 of the table. The size of the ring is a power of 2.
+  std::vector<MIMEField *> _entries;
+  uint64_t _inserted = 0; ///< Entries ever added.
+  uint32_t _length   = 0; ///< Entries in the table.
+  // Hashes of the names, and of the names with the values, to the numbers of the entries with them.
+  std::unordered_multimap<uint64_t, uint64_t> _name_index;
+  std::unordered_multimap<uint64_t, uint64_t> _field_index;
 };
 
 // [RFC 7541] 2.3. Indexing Table
@@ -61,6 +61,8 @@ static const char *const HTTP2_STAT_SESSION_DIE_ACTIVE_NAME      = "proxy.proces
 static const char *const HTTP2_STAT_SESSION_DIE_INACTIVE_NAME    = "proxy.process.http2.session_die_inactive";
 static const char *const HTTP2_STAT_SESSION_DIE_EOS_NAME         = "proxy.process.http2.session_die_eos";
 static const char *const HTTP2_STAT_SESSION_DIE_ERROR_NAME       = "proxy.process.http2.session_die_error";
+static const char *const HTTP2_STAT_FRAMES_PER_WRITE_NAME        = "proxy.process.http2.avg_frames_per_write";
+static const char *const HTTP2_STAT_PRIORITY_IGNORED_NAME        = "proxy.process.http2.priority_ignored";
 
 union byte_pointer {
   byte_pointer(void *p) : ptr(p) {}
@@ -716,20 +718,24 @@ http2_decode_header_blocks(HTTPHdr *hdr, const uint8_t *buf_start, const uint32_
 }
 
 // Initialize this subsystem with librecords configs (for now)
-uint32_t Http2::max_concurrent_streams_in  = 100;
-uint32_t Http2::min_concurrent_streams_in  = 10;
-uint32_t Http2::max_active_streams_in      = 0;
-bool Http2::throttling                     = false;
-uint32_t Http2::stream_priority_enabled    = 0;
-uint32_t Http2::initial_window_size        = 1048576;
-uint32_t Http2::max_frame_size             = 16384;
-uint32_t Http2::header_table_size          = 4096;
-uint32_t Http2::max_header_list_size       = 4294967295;
-uint32_t Http2::max_request_header_size    = 131072;
-uint32_t Http2::accept_no_activity_timeout = 120;
-uint32_t Http2::no_activity_timeout_in     = 120;
-uint32_t Http2::active_timeout_in          = 0;
-uint32_t Http2::push_diary_size            = 256;
+uint32_t Http2::max_concurrent_streams_in      = 100;
+uint32_t Http2::min_concurrent_streams_in      = 10;
+uint32_t Http2::max_active_streams_in          = 0;
+bool Http2::throttling                         = false;
+uint32_t Http2::stream_priority_enabled        = 0;
+uint32_t Http2::initial_window_size            = 1048576;
+uint32_t Http2::max_frame_size                 = 16384;
+uint32_t Http2::header_table_size              = 4096;
+uint32_t Http2::max_header_list_size           = 4294967295;
+uint32_t Http2::max_request_header_size        = 131072;
+uint32_t Http2::accept_no_activity_timeout     = 120;
+uint32_t Http2::no_activity_timeout_in         = 120;
+uint32_t Http2::active_timeout_in              = 0;
+uint32_t Http2::push_diary_size                = 256;
+uint32_t Http2::max_connection_memory          = 0;
+uint32_t Http2::write_coalesce_size            = 16384;
+uint32_t Http2::data_frames_per_pass           = 8;
+uint32_t Http2::max_priority_frames_per_minute = 0;
 
 void
 Http2::init()
@@ -747,6 +753,10 @@ Http2::init()
   REC_EstablishStaticConfigInt32U(no_activity_timeout_in, "proxy.config.http2.no_activity_timeout_in");
   REC_EstablishStaticConfigInt32U(active_timeout_in, "proxy.config.http2.active_timeout_in");
   REC_EstablishStaticConfigInt32U(push_diary_size, "proxy.config.http2.push_diary_size");
+  REC_EstablishStaticConfigInt32U(max_connection_memory, "proxy.config.http2.max_connection_memory");
+  REC_EstablishStaticConfigInt32U(write_coalesce_size, "proxy.config.http2.write_coalesce_size");
+  REC_EstablishStaticConfigInt32U(data_frames_per_pass, "proxy.config.http2.data_frames_per_pass");
+  REC_EstablishStaticConfigInt32U(max_priority_frames_per_minute, "proxy.config.http2.max_priority_frames_per_minute");
 
   // If any settings is broken, ATS should not start
   ink_release_assert(http2_settings_parameter_is_valid({HTTP2_SETTINGS_MAX_CONCURRENT_STREAMS, max_concurrent_streams_in}));
@@ -792,6 +802,10 @@ Http2::init()
                      static_cast<int>(HTTP2_STAT_SESSION_DIE_INACTIVE), RecRawStatSyncSum);
   RecRegisterRawStat(http2_rsb, RECT_PROCESS, HTTP2_STAT_SESSION_DIE_ERROR_NAME, RECD_INT, RECP_PERSISTENT,
                      static_cast<int>(HTTP2_STAT_SESSION_DIE_ERROR), RecRawStatSyncSum);
+  RecRegisterRawStat(http2_rsb, RECT_PROCESS, HTTP2_STAT_FRAMES_PER_WRITE_NAME, RECD_FLOAT, RECP_NON_PERSISTENT,
+                     static_cast<int>(HTTP2_STAT_FRAMES_PER_WRITE), RecRawStatSyncAvg);
+  RecRegisterRawStat(http2_rsb, RECT_PROCESS, HTTP2_STAT_PRIORITY_IGNORED_NAME, RECD_INT, RECP_PERSISTENT,
+                     static_cast<int>(HTTP2_STAT_PRIORITY_IGNORED), RecRawStatSyncSum);
 }
 
 #if TS_HAS_TESTS
@@ -83,6 +83,8 @@ enum {
   HTTP2_STAT_SESSION_DIE_INACTIVE,
   HTTP2_STAT_SESSION_DIE_EOS,
   HTTP2_STAT_SESSION_DIE_ERROR,
+  HTTP2_STAT_FRAMES_PER_WRITE, // Frames written to the connection at once
+  HTTP2_STAT_PRIORITY_IGNORED, // Connections whose priorities are ignored
 
   HTTP2_N_STATS // Terminal counter, NOT A STAT INDEX.
 };
@@ -377,6 +379,10 @@ public:
   static uint32_t no_activity_timeout_in;
   static uint32_t active_timeout_in;
   static uint32_t push_diary_size;
+  static uint32_t max_connection_memory;
+  static uint32_t write_coalesce_size;
+  static uint32_t data_frames_per_pass;
+  static uint32_t max_priority_frames_per_minute;
 
   static void init();
 };
@@ -78,6 +78,11 @@ Http2ClientSession::free()
     this->h2_pushed_urls = ink_hash_table_destroy(this->h2_pushed_urls);
   }
 
+  if (write_flush_event) {
+    write_flush_event->cancel();
+    write_flush_event = nullptr;
+  }
+
   if (client_vc) {
     release_netvc();
     client_vc->do_io_close();
@@ -185,7 +190,10 @@ Http2ClientSession::new_connection(NetVConnection *new_vc, MIOBuffer *iobuf, IOB
   this->h2_pushed_urls          = ink_hash_table_create(InkHashTableKeyType_String);
   this->h2_pushed_urls_size     = 0;
 
-  this->write_buffer = new_MIOBuffer(HTTP2_HEADER_BUFFER_SIZE_INDEX);
+  // The small frames are coalesced in blocks of about proxy.config.http2.write_coalesce_size, each is sent in one TLS record
+  this->write_buffer = new_MIOBuffer(Http2::write_coalesce_size ?
+                                       buffer_size_to_index(Http2::write_coalesce_size, MAX_BUFFER_SIZE_INDEX) :
+                                       HTTP2_HEADER_BUFFER_SIZE_INDEX);
   this->sm_writer    = this->write_buffer->alloc_reader();
 
   do_api_callout(TS_HTTP_SSN_START_HOOK);
@@ -315,12 +323,24 @@ Http2ClientSession::main_event_handler(int event, void *edata)
     Http2Frame *frame = (Http2Frame *)edata;
     total_write_len += frame->size();
     write_vio->nbytes = total_write_len;
-    frame->xmit(this->write_buffer);
-    write_reenable();
+    frame->xmit(this->write_buffer, Http2::write_coalesce_size);
+    ++write_frames;
+    // The frames sent while handling this event, and any others in this event loop pass, are written together
+    if (!Http2::write_coalesce_size) {
+      flush_write();
+    } else if (!write_flush_event) {
+      write_flush_event = this_ethread()->schedule_imm_local(this, HTTP2_SESSION_EVENT_FLUSH);
+    }
     retval = 0;
     break;
   }
 
+  case HTTP2_SESSION_EVENT_FLUSH:
+    write_flush_event = nullptr;
+    flush_write();
+    retval = 0;
+    break;
+
   case VC_EVENT_ACTIVE_TIMEOUT:
   case VC_EVENT_INACTIVITY_TIMEOUT:
   case VC_EVENT_ERROR:
@@ -365,6 +385,16 @@ Http2ClientSession::main_event_handler(int event, void *edata)
   return retval;
 }
 
+void
+Http2ClientSession::flush_write()
+{
+  if (write_frames && client_vc) {
+    HTTP2_SUM_THREAD_DYN_STAT(HTTP2_STAT_FRAMES_PER_WRITE, this_ethread(), write_frames);
+    write_reenable();
+  }
+  write_frames = 0;
+}
+
 int
 Http2ClientSession::state_read_connection_preface(int event, void *edata)
 {
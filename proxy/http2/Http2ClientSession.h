@@ -35,6 +35,7 @@
 // HTTP2_SESSION_EVENT_FINI   Http2ClientSession *  HTTP/2 session is ended
 // HTTP2_SESSION_EVENT_RECV   Http2Frame *          Received a frame
 // HTTP2_SESSION_EVENT_XMIT   Http2Frame *          Send this frame
+// HTTP2_SESSION_EVENT_FLUSH  Event *               Write the frames sent in this event loop pass
 
 #define HTTP2_SESSION_EVENT_INIT (HTTP2_SESSION_EVENTS_START + 1)
 #define HTTP2_SESSION_EVENT_FINI (HTTP2_SESSION_EVENTS_START + 2)
@@ -42,6 +43,7 @@
 #define HTTP2_SESSION_EVENT_XMIT (HTTP2_SESSION_EVENTS_START + 4)
 #define HTTP2_SESSION_EVENT_SHUTDOWN_INIT (HTTP2_SESSION_EVENTS_START + 5)
 #define HTTP2_SESSION_EVENT_SHUTDOWN_CONT (HTTP2_SESSION_EVENTS_START + 6)
+#define HTTP2_SESSION_EVENT_FLUSH (HTTP2_SESSION_EVENTS_START + 7)
 
 size_t const HTTP2_HEADER_BUFFER_SIZE_INDEX = CLIENT_CONNECTION_FIRST_READ_BUFFER_SIZE_INDEX;
 
@@ -117,8 +119,10 @@ public:
     }
   }
 
+  // A payload smaller than @a copy_size is copied rather than appended, so that small frames end up
+  // together in the blocks of @a iobuffer.
   void
-  xmit(MIOBuffer *iobuffer)
+  xmit(MIOBuffer *iobuffer, int64_t copy_size = 0)
   {
     // Write frame header
     uint8_t buf[HTTP2_FRAME_HEADER_LEN];
@@ -128,7 +132,11 @@ public:
     // Write frame payload
     // It could be empty (e.g. SETTINGS frame with ACK flag)
     if (ioblock && ioblock->read_avail() > 0) {
-      iobuffer->append_block(this->ioblock.get());
+      if (ioblock->read_avail() < copy_size) {
+        iobuffer->write(ioblock->start(), ioblock->read_avail());
+      } else {
+        iobuffer->append_block(this->ioblock.get());
+      }
     }
   }
 
@@ -215,6 +223,8 @@ public:
     write_vio->reenable();
   }
 
+  void flush_write();
+
   void set_upgrade_context(HTTPHdr *h);
 
   const Http2UpgradeContext &
@@ -336,6 +346,8 @@ private:
   int state_process_frame_read(int event, VIO *vio, bool inside_frame);
 
   int64_t total_write_len        = 0;
+  int write_frames               = 0;       ///< Frames sent since the last flush_write().
+  Event *write_flush_event       = nullptr; ///< flush_write() at the end of this event loop pass.
   SessionHandler session_handler = nullptr;
   NetVConnection *client_vc      = nullptr;
   MIOBuffer *read_buffer         = nullptr;
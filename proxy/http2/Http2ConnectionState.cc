@@ -279,6 +279,10 @@ rcv_headers_frame(Http2ConnectionState &cstate, const Http2Frame &frame)
   }
 
   if (new_stream && Http2::stream_priority_enabled) {
+    if (cstate.is_priority_ignored()) {
+      params.priority = Http2Priority();
+    }
+
     Http2DependencyTree::Node *node = cstate.dependency_tree->find(stream_id);
     if (node != nullptr) {
       stream->priority_node = node;
@@ -396,6 +400,10 @@ rcv_priority_frame(Http2ConnectionState &cstate, const Http2Frame &frame)
                       "PRIORITY frame depends on itself");
   }
 
+  if (!cstate.accept_priority_frame()) {
+    return Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_NONE);
+  }
+
   Http2StreamDebug(cstate.ua_session, stream_id, "PRIORITY - dep: %d, weight: %d, excl: %d, tree size: %d",
                    priority.stream_dependency, priority.weight, priority.exclusive_flag, cstate.dependency_tree->size());
 
@@ -1039,6 +1047,14 @@ Http2ConnectionState::create_stream(Http2StreamId new_id, Http2Error &error)
     }
   }
 
+  // The streams that are shutting down are not limited by SETTINGS_MAX_CONCURRENT_STREAMS, a client that
+  // resets its streams quickly could make the connection hold any number of them.
+  if (Http2::max_connection_memory && memory_used() + sizeof(Http2Stream) > Http2::max_connection_memory) {
+    error = Http2Error(Http2ErrorClass::HTTP2_ERROR_CLASS_STREAM, Http2ErrorCode::HTTP2_ERROR_REFUSED_STREAM,
+                       "recv headers creating stream beyond connection memory limit");
+    return nullptr;
+  }
+
   Http2Stream *new_stream = THREAD_ALLOC_INIT(http2StreamAllocator, this_ethread());
   new_stream->init(new_id, client_settings.get(HTTP2_SETTINGS_INITIAL_WINDOW_SIZE));
 
@@ -1046,6 +1062,7 @@ Http2ConnectionState::create_stream(Http2StreamId new_id, Http2Error &error)
   ink_assert(!stream_list.in(new_stream));
 
   stream_list.enqueue(new_stream);
+  stream_map[new_id] = new_stream;
   if (client_streamid) {
     latest_streamid_in = new_id;
     ink_assert(client_streams_in_count < UINT32_MAX);
@@ -1069,13 +1086,20 @@ Http2ConnectionState::create_stream(Http2StreamId new_id, Http2Error &error)
 Http2Stream *
 Http2ConnectionState::find_stream(Http2StreamId id) const
 {
-  for (Http2Stream *s = stream_list.head; s; s = static_cast<Http2Stream *>(s->link.next)) {
-    if (s->get_id() == id) {
-      return s;
-    }
-    ink_assert(s != s->link.next);
-  }
-  return nullptr;
+  auto spot = stream_map.find(id);
+  return spot == stream_map.end() ? nullptr : spot->second;
+}
+
+// The streams, including the ones shutting down, their index and the HPACK tables.
+size_t
+Http2ConnectionState::memory_used() const
+{
+  // a node of stream_map holds an entry and the next pointer, and a bucket is a pointer
+  size_t map_size = stream_map.size() * (sizeof(decltype(stream_map)::value_type) + sizeof(void *)) +
+                    stream_map.bucket_count() * sizeof(void *);
+
+  return sizeof(*this) + total_client_streams_count * sizeof(Http2Stream) + map_size + local_hpack_handle->size() +
+         remote_hpack_handle->size();
 }
 
 void
@@ -1175,6 +1199,7 @@ Http2ConnectionState::delete_stream(Http2Stream *stream)
   }
 
   stream_list.remove(stream);
+  stream_map.erase(stream->get_id());
   if (http2_is_client_streamid(stream->get_id())) {
     ink_assert(client_streams_in_count > 0);
     --client_streams_in_count;
@@ -1256,45 +1281,74 @@ Http2ConnectionState::schedule_stream(Http2Stream *stream)
   }
 }
 
+// Count a PRIORITY frame, the priorities of a client which sends too many are ignored from then on
+bool
+Http2ConnectionState::accept_priority_frame()
+{
+  if (priority_ignored) {
+    return false;
+  }
+  if (Http2::max_priority_frames_per_minute == 0) {
+    return true;
+  }
+
+  ink_hrtime now = Thread::get_hrtime();
+  if (now - priority_window_start >= HRTIME_MINUTE) {
+    priority_window_start = now;
+    priority_frames       = 0;
+  }
+  if (++priority_frames <= Http2::max_priority_frames_per_minute) {
+    return true;
+  }
+
+  Http2ConDebug(ua_session, "Ignore priorities, %u PRIORITY frames in a minute", priority_frames);
+  priority_ignored = true;
+  HTTP2_INCREMENT_THREAD_DYN_STAT(HTTP2_STAT_PRIORITY_IGNORED, this_ethread());
+  return false;
+}
+
 void
 Http2ConnectionState::send_data_frames_depends_on_priority()
 {
-  Http2DependencyTree::Node *node = dependency_tree->top();
+  // Send a few frames at a time so one connection does not hold the thread
+  for (uint32_t i = 0; i < std::max(Http2::data_frames_per_pass, 1U); ++i) {
+    Http2DependencyTree::Node *node = dependency_tree->top();
 
-  // No node to send or no connection level window left
-  if (node == nullptr || client_rwnd <= 0) {
-    return;
-  }
+    // No node to send or no connection level window left
+    if (node == nullptr || client_rwnd <= 0 || is_state_closed()) {
+      return;
+    }
 
-  Http2Stream *stream = static_cast<Http2Stream *>(node->t);
-  ink_release_assert(stream != nullptr);
-  Http2StreamDebug(ua_session, stream->get_id(), "top node, point=%d", node->point);
+    Http2Stream *stream = static_cast<Http2Stream *>(node->t);
+    ink_release_assert(stream != nullptr);
+    Http2StreamDebug(ua_session, stream->get_id(), "top node, point=%d", node->point);
 
-  size_t len                      = 0;
-  Http2SendDataFrameResult result = send_a_data_frame(stream, len);
+    size_t len                      = 0;
+    Http2SendDataFrameResult result = send_a_data_frame(stream, len);
 
-  switch (result) {
-  case Http2SendDataFrameResult::NO_ERROR: {
-    // No response body to send
-    if (len == 0 && !stream->is_body_done()) {
-      dependency_tree->deactivate(node, len);
-    } else {
-      dependency_tree->update(node, len);
+    switch (result) {
+    case Http2SendDataFrameResult::NO_ERROR: {
+      // No response body to send
+      if (len == 0 && !stream->is_body_done()) {
+        dependency_tree->deactivate(node, len);
+      } else {
+        dependency_tree->update(node, len);
 
-      SCOPED_MUTEX_LOCK(stream_lock, stream->mutex, this_ethread());
-      stream->signal_write_event(true);
+        SCOPED_MUTEX_LOCK(stream_lock, stream->mutex, this_ethread());
+        stream->signal_write_event(true);
+      }
+      break;
+    }
+    case Http2SendDataFrameResult::DONE: {
+      dependency_tree->deactivate(node, len);
+      delete_stream(stream);
+      break;
+    }
+    default:
+      // When no stream level window left, deactivate node once and wait window_update frame
+      dependency_tree->deactivate(node, len);
+      break;
     }
-    break;
-  }
-  case Http2SendDataFrameResult::DONE: {
-    dependency_tree->deactivate(node, len);
-    delete_stream(stream);
-    break;
-  }
-  default:
-    // When no stream level window left, deactivate node once and wait window_update frame
-    dependency_tree->deactivate(node, len);
-    break;
   }
 
   this_ethread()->schedule_imm_local((Continuation *)this, HTTP2_SESSION_EVENT_XMIT);
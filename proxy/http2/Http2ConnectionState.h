@@ -27,6 +27,7 @@
 #include "HPACK.h"
 #include "Http2Stream.h"
 #include "Http2DependencyTree.h"
+#include <unordered_map>
 
 class Http2ClientSession;
 
@@ -170,6 +171,7 @@ public:
   bool delete_stream(Http2Stream *stream);
   void release_stream(Http2Stream *stream);
   void cleanup_streams();
+  size_t memory_used() const;
 
   void update_initial_rwnd(Http2WindowSize new_size);
 
@@ -220,6 +222,14 @@ public:
     return client_streams_in_count;
   }
 
+  // Stream priorities from the client
+  bool accept_priority_frame();
+  bool
+  is_priority_ignored() const
+  {
+    return priority_ignored;
+  }
+
   // Connection level window size
   ssize_t client_rwnd = HTTP2_INITIAL_WINDOW_SIZE;
   ssize_t server_rwnd = Http2::initial_window_size;
@@ -285,6 +295,8 @@ private:
   //   If given Stream Identifier is not found in stream_list and it is greater
   //   than latest_streamid_in, the state of Stream is IDLE.
   Queue<Http2Stream> stream_list;
+  // The streams in stream_list by Stream Identifier, frames are looked up in it.
+  std::unordered_map<Http2StreamId, Http2Stream *> stream_map;
   Http2StreamId latest_streamid_in  = 0;
   Http2StreamId latest_streamid_out = 0;
   int stream_requests               = 0;
@@ -309,6 +321,9 @@ private:
   IOVec continued_buffer;
   bool _scheduled                   = false;
   bool fini_received                = false;
+  bool priority_ignored             = false;
+  uint32_t priority_frames          = 0; // PRIORITY frames received since priority_window_start
+  ink_hrtime priority_window_start  = 0;
   int recursion                     = 0;
   Http2ShutdownState shutdown_state = HTTP2_SHUTDOWN_NONE;
   Event *shutdown_cont_event        = nullptr;
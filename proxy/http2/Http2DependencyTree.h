@@ -28,36 +28,33 @@
 
 #include "ts/List.h"
 #include "ts/Diags.h"
-#include "ts/PriorityQueue.h"
 
 #include "HTTP2.h"
 
+#include <unordered_map>
+#include <vector>
+
 // TODO: K is a constant, 256 is temporal value.
 const static uint32_t K                               = 256;
 const static uint32_t HTTP2_DEPENDENCY_TREE_MAX_DEPTH = 256;
 
 namespace Http2DependencyTree
 {
+/** A stream, or a placeholder for one, in the tree.
+
+    The children which are active or have active descendants are kept in a binary heap ordered
+    by point, in an array in the node itself rather than in separately allocated queue entries.
+    The child on top is served next and its point is advanced by the bytes sent divided by its
+    weight (stride scheduling).
+ */
 class Node
 {
 public:
-  Node(void *t = nullptr) : t(t)
-  {
-    entry = new PriorityQueueEntry<Node *>(this);
-    queue = new PriorityQueue<Node *>();
-  }
-
-  Node(uint32_t i, uint32_t w, uint32_t p, Node *n, void *t = nullptr) : id(i), weight(w), point(p), t(t), parent(n)
-  {
-    entry = new PriorityQueueEntry<Node *>(this);
-    queue = new PriorityQueue<Node *>();
-  }
+  Node(void *t = nullptr) : t(t) {}
+  Node(uint32_t i, uint32_t w, uint32_t p, Node *n, void *t = nullptr) : id(i), weight(w), point(p), t(t), parent(n) {}
 
   ~Node()
   {
-    delete entry;
-    delete queue;
-
     // delete all child nodes
     if (!children.empty()) {
       Node *node = children.head;
@@ -73,39 +70,145 @@ public:
 
   LINK(Node, link);
 
+  // Compare the distance so the points may wrap around, the stream id breaks ties.
   bool
   operator<(const Node &n) const
   {
-    return point < n.point;
+    int32_t d = static_cast<int32_t>(point - n.point);
+    return d < 0 || (d == 0 && id < n.id);
   }
+
   bool
-  operator>(const Node &n) const
+  is_shadow() const
   {
-    return point > n.point;
+    return t == nullptr;
   }
 
+  /// Whether @a n is queued on this node.
   bool
-  is_shadow() const
+  in_queue(const Node *n) const
   {
-    return t == nullptr;
+    return n->queued && n->queue_index < queue.size() && queue[n->queue_index] == n;
+  }
+
+  /// The child to serve next, nullptr if none of them is active.
+  Node *
+  next() const
+  {
+    return queue.empty() ? nullptr : queue[0];
   }
 
-  bool active     = false;
-  bool queued     = false;
-  uint32_t id     = HTTP2_PRIORITY_DEFAULT_STREAM_DEPENDENCY;
-  uint32_t weight = HTTP2_PRIORITY_DEFAULT_WEIGHT;
-  uint32_t point  = 0;
-  void *t         = nullptr;
-  Node *parent    = nullptr;
+  void
+  push(Node *n)
+  {
+    ink_assert(!n->queued);
+    // A child joining the queue starts where the others are, otherwise one which was idle for a
+    // while would take all of the bandwidth until it caught up.
+    if (static_cast<int32_t>(n->point - vtime) < 0) {
+      n->point = vtime;
+    }
+    n->queued = true;
+    _set(queue.size(), n);
+    _bubble_up(n->queue_index);
+  }
+
+  void
+  erase(Node *n)
+  {
+    if (!in_queue(n)) {
+      return;
+    }
+    uint32_t index = n->queue_index;
+    Node *last     = queue.back();
+    queue.pop_back();
+    n->queued = false;
+    if (last != n) {
+      _set(index, last);
+      _bubble_down(index);
+      _bubble_up(last->queue_index);
+    }
+  }
+
+  /// Restore the order after the point of @a n changed, it only moves down if @a increased.
+  void
+  reorder(Node *n, bool increased = false)
+  {
+    if (in_queue(n)) {
+      _bubble_down(n->queue_index);
+      if (!increased) {
+        _bubble_up(n->queue_index);
+      }
+    }
+  }
+
+  bool active          = false;
+  bool queued          = false;
+  uint32_t id          = HTTP2_PRIORITY_DEFAULT_STREAM_DEPENDENCY;
+  uint32_t weight      = HTTP2_PRIORITY_DEFAULT_WEIGHT;
+  uint32_t point       = 0;
+  uint32_t vtime       = 0; ///< Point of the child served last.
+  uint32_t queue_index = 0; ///< Where this node is in the sibling group of its parent.
+  void *t              = nullptr;
+  Node *parent         = nullptr;
   DLL<Node> children;
-  PriorityQueueEntry<Node *> *entry;
-  PriorityQueue<Node *> *queue;
+  std::vector<Node *> queue; ///< Children which are active or have active descendants.
+
+private:
+  void
+  _set(uint32_t index, Node *n)
+  {
+    if (index == queue.size()) {
+      queue.push_back(n);
+    } else {
+      queue[index] = n;
+    }
+    n->queue_index = index;
+  }
+
+  void
+  _bubble_up(uint32_t index)
+  {
+    Node *n = queue[index];
+    while (index != 0) {
+      uint32_t parent = (index - 1) / 2;
+      if (!(*n < *queue[parent])) {
+        break;
+      }
+      _set(index, queue[parent]);
+      index = parent;
+    }
+    _set(index, n);
+  }
+
+  void
+  _bubble_down(uint32_t index)
+  {
+    Node *n = queue[index];
+    while (true) {
+      uint32_t child = index * 2 + 1;
+      if (child >= queue.size()) {
+        break;
+      }
+      if (child + 1 < queue.size() && *queue[child + 1] < *queue[child]) {
+        ++child;
+      }
+      if (!(*queue[child] < *n)) {
+        break;
+      }
+      _set(index, queue[child]);
+      index = child;
+    }
+    _set(index, n);
+  }
 };
 
 template <typename T> class Tree
 {
 public:
-  Tree(uint32_t max_concurrent_streams) : _max_depth(MIN(max_concurrent_streams, HTTP2_DEPENDENCY_TREE_MAX_DEPTH)) {}
+  Tree(uint32_t max_concurrent_streams) : _max_depth(MIN(max_concurrent_streams, HTTP2_DEPENDENCY_TREE_MAX_DEPTH))
+  {
+    _index[_root->id] = _root;
+  }
 
   ~Tree() { delete _root; }
   Node *find(uint32_t id);
@@ -122,50 +225,39 @@ public:
   uint32_t size() const;
 
 private:
-  Node *_find(Node *node, uint32_t id, uint32_t depth = 1);
-  Node *_top(Node *node);
+  uint32_t _depth(const Node *node) const;
   void _change_parent(Node *new_parent, Node *node, bool exclusive);
 
   Node *_root = new Node(this);
   uint32_t _max_depth;
   uint32_t _node_count = 0;
+  std::unordered_map<uint32_t, Node *> _index;
 };
 
 template <typename T>
-Node *
-Tree<T>::_find(Node *node, uint32_t id, uint32_t depth)
+uint32_t
+Tree<T>::_depth(const Node *node) const
 {
-  if (node->id == id) {
-    return node;
-  }
-
-  if (node->children.empty() || depth >= _max_depth) {
-    return nullptr;
+  uint32_t depth = 0;
+  for (; node->parent != nullptr; node = node->parent) {
+    ++depth;
   }
-
-  Node *result = nullptr;
-  for (Node *n = node->children.head; n; n = n->link.next) {
-    result = _find(n, id, ++depth);
-    if (result != nullptr) {
-      break;
-    }
-  }
-
-  return result;
+  return depth;
 }
 
 template <typename T>
 Node *
 Tree<T>::find_shadow(uint32_t id)
 {
-  return _find(_root, id);
+  auto spot = _index.find(id);
+  return spot == _index.end() ? nullptr : spot->second;
 }
 
 template <typename T>
 Node *
 Tree<T>::find(uint32_t id)
 {
-  Node *n = _find(_root, id);
+  Node *n = find_shadow(id);
   return n == nullptr ? nullptr : (n->is_shadow() ? nullptr : n);
 }
 
@@ -173,16 +265,24 @@ template <typename T>
 Node *
 Tree<T>::add(uint32_t parent_id, uint32_t id, uint32_t weight, bool exclusive, T t)
 {
-  Node *parent = find(parent_id);
+  Node *parent = find_shadow(parent_id);
   if (parent == nullptr) {
     parent = add(0, parent_id, HTTP2_PRIORITY_DEFAULT_WEIGHT, false, nullptr);
+  } else if (_depth(parent) >= _max_depth) {
+    // Too deep, depend on the top of the branch instead so the branch keeps its share.
+    while (parent->parent != _root) {
+      parent = parent->parent;
+    }
   }
 
   Node *node = find_shadow(id);
-  if (node != nullptr && node->is_shadow()) {
-    node->t      = t;
-    node->point  = id;
-    node->weight = weight;
+  if (node != nullptr) {
+    if (node->is_shadow()) {
+      node->t      = t;
+      node->point  = id;
+      node->weight = weight;
+      node->parent->reorder(node);
+    }
     return node;
   }
 
@@ -192,8 +292,8 @@ Tree<T>::add(uint32_t parent_id, uint32_t id, uint32_t weight, bool exclusive, T
   if (exclusive) {
     while (Node *child = parent->children.pop()) {
       if (child->queued) {
-        parent->queue->erase(child->entry);
-        node->queue->push(child->entry);
+        parent->erase(child);
+        node->push(child);
       }
       node->children.push(child);
       child->parent = node;
@@ -201,12 +301,11 @@ Tree<T>::add(uint32_t parent_id, uint32_t id, uint32_t weight, bool exclusive, T
   }
 
   parent->children.push(node);
-  if (!node->queue->empty()) {
-    ink_release_assert(!node->queued);
-    parent->queue->push(node->entry);
-    node->queued = true;
+  if (!node->queue.empty()) {
+    parent->push(node);
   }
 
+  _index[id] = node;
   ++_node_count;
   return node;
 }
@@ -215,21 +314,18 @@ template <typename T>
 bool
 Tree<T>::in(Node *current, Node *node)
 {
-  bool retval = false;
-  if (current == nullptr)
+  if (current == nullptr) {
     current = _root;
-  if (current->queue->in(node->entry)) {
+  }
+  if (current->in_queue(node)) {
     return true;
-  } else {
-    Node *child = current->children.head;
-    while (child) {
-      if (in(child, node)) {
-        return true;
-      }
-      child = child->link.next;
+  }
+  for (Node *child = current->children.head; child; child = child->link.next) {
+    if (in(child, node)) {
+      return true;
     }
   }
-  return retval;
+  return false;
 }
 
 template <typename T>
@@ -242,15 +338,14 @@ Tree<T>::remove(Node *node)
 
   Node *parent = node->parent;
   parent->children.remove(node);
-  if (node->queued) {
-    parent->queue->erase(node->entry);
-  }
+  parent->erase(node);
 
-  // Push queue entries
-  while (!node->queue->empty()) {
-    parent->queue->push(node->queue->top());
-    node->queue->pop();
+  // Move the sibling group
+  for (Node *n : node->queue) {
+    n->queued = false;
+    parent->push(n);
   }
+  node->queue.clear();
 
   // Push children
   while (!node->children.empty()) {
@@ -260,12 +355,11 @@ Tree<T>::remove(Node *node)
   }
 
   // delete the shadow parent
-  if (parent->is_shadow() && parent->children.empty() && parent->queue->empty()) {
+  if (parent->is_shadow() && parent->children.empty() && parent->queue.empty()) {
     remove(parent);
   }
 
-  // ink_release_assert(!this->in(nullptr, node));
-
+  _index.erase(node->id);
   --_node_count;
   delete node;
 }
@@ -299,14 +393,21 @@ Tree<T>::reprioritize(Node *node, uint32_t new_parent_id, bool exclusive)
   ink_assert(node->parent);
 
   Node *new_parent = find(new_parent_id);
-  if (new_parent == nullptr) {
+  if (new_parent == nullptr || new_parent == node || _depth(new_parent) >= _max_depth) {
     return;
   }
-  _change_parent(new_parent, old_parent, false);
+
+  // [RFC 7540] 5.3.3 a node which depends on its own dependent takes its place first
+  for (Node *n = new_parent->parent; n != nullptr; n = n->parent) {
+    if (n == node) {
+      _change_parent(new_parent, old_parent, false);
+      break;
+    }
+  }
   _change_parent(node, new_parent, exclusive);
 
   // delete the shadow node
-  if (node->is_shadow() && node->children.empty() && node->queue->empty()) {
+  if (node->is_shadow() && node->children.empty() && node->queue.empty()) {
     remove(node);
   }
 }
@@ -319,14 +420,12 @@ Tree<T>::_change_parent(Node *node, Node *new_parent, bool exclusive)
   ink_release_assert(node->parent != nullptr);
   node->parent->children.remove(node);
   if (node->queued) {
-    node->parent->queue->erase(node->entry);
-    node->queued = false;
+    node->parent->erase(node);
 
     Node *current = node->parent;
-    while (current->queue->empty() && !current->active && current->parent != nullptr) {
-      current->parent->queue->erase(current->entry);
-      current->queued = false;
-      current         = current->parent;
+    while (current->queue.empty() && !current->active && current->parent != nullptr) {
+      current->parent->erase(current);
+      current = current->parent;
     }
   }
 
@@ -334,8 +433,8 @@ Tree<T>::_change_parent(Node *node, Node *new_parent, bool exclusive)
   if (exclusive) {
     while (Node *child = new_parent->children.pop()) {
       if (child->queued) {
-        child->parent->queue->erase(child->entry);
-        node->queue->push(child->entry);
+        new_parent->erase(child);
+        node->push(child);
       }
 
       node->children.push(child);
@@ -346,40 +445,26 @@ Tree<T>::_change_parent(Node *node, Node *new_parent, bool exclusive)
   new_parent->children.push(node);
   node->parent = new_parent;
 
-  if (node->active || !node->queue->empty()) {
+  if (node->active || !node->queue.empty()) {
     Node *current = node;
     while (current->parent != nullptr && !current->queued) {
-      current->parent->queue->push(current->entry);
-      current->queued = true;
-      current         = current->parent;
+      current->parent->push(current);
+      current = current->parent;
     }
   }
 }
 
 template <typename T>
 Node *
-Tree<T>::_top(Node *node)
+Tree<T>::top()
 {
-  Node *child = node;
+  Node *node = _root;
 
-  while (child != nullptr) {
-    if (child->active) {
-      return child;
-    } else if (!child->queue->empty()) {
-      child = child->queue->top()->node;
-    } else {
-      return nullptr;
-    }
+  while (node != nullptr && !node->active) {
+    node = node->next();
   }
 
-  return child;
-}
-
-template <typename T>
-Node *
-Tree<T>::top()
-{
-  return _top(_root);
+  return node;
 }
 
 template <typename T>
@@ -389,9 +474,8 @@ Tree<T>::activate(Node *node)
   node->active = true;
 
   while (node->parent != nullptr && !node->queued) {
-    node->parent->queue->push(node->entry);
-    node->queued = true;
-    node         = node->parent;
+    node->parent->push(node);
+    node = node->parent;
   }
 }
 
@@ -401,10 +485,8 @@ Tree<T>::deactivate(Node *node, uint32_t sent)
 {
   node->active = false;
 
-  while (node->queue->empty() && node->parent != nullptr) {
-    node->parent->queue->erase(node->entry);
-    node->queued = false;
-
+  while (node->queue.empty() && !node->active && node->parent != nullptr) {
+    node->parent->erase(node);
     node = node->parent;
   }
 
@@ -416,16 +498,16 @@ void
 Tree<T>::update(Node *node, uint32_t sent)
 {
   while (node->parent != nullptr) {
-    node->point += sent * K / (node->weight + 1);
+    Node *parent = node->parent;
 
-    if (node->queued) {
-      node->parent->queue->update(node->entry, true);
-    } else {
-      node->parent->queue->push(node->entry);
-      node->queued = true;
+    if (!node->queued) {
+      parent->push(node);
     }
+    parent->vtime = node->point;
+    node->point += sent * K / (node->weight + 1);
+    parent->reorder(node, true);
 
-    node = node->parent;
+    node = parent;
   }
 }
 
@@ -25,6 +25,7 @@
 #include "ts/ink_platform.h"
 #include "ts/ink_memory.h"
 #include "ts/ink_defs.h"
+#include "ts/ink_assert.h"
 
 struct huffman_entry {
   uint32_t code_as_hex;
@@ -74,10 +75,30 @@ typedef struct node {
   node *left, *right;
   char ascii_code;
   bool leaf_node;
+  bool eos;      // leaf of the EOS symbol
+  bool accept;   // decoding may stop here, only padding was consumed since the last symbol
+  uint8_t state; // index of an internal node in huffman_decode_table
 } Node;
 
 Node *HUFFMAN_TREE_ROOT;
 
+// Entries of the decoding state machine, see build_huffman_decode_table().
+enum {
+  HUFFMAN_DECODE_ACCEPT = 0x1, // the input may end in this state
+  HUFFMAN_DECODE_SYMBOL = 0x2, // a symbol was completed while consuming the nibble
+  HUFFMAN_DECODE_FAIL   = 0x4, // the nibble decodes EOS, which is a decoding error
+};
+
+struct huffman_decode_entry {
+  uint8_t state;
+  uint8_t flags;
+  uint8_t symbol;
+};
+
+// Each of the 256 internal nodes of the tree is a state, the input is consumed 4 bits at a time.
+static huffman_decode_entry huffman_decode_table[256][16];
+static bool huffman_decode_table_ready = false;
+
 static Node *
 make_huffman_tree_node()
 {
@@ -86,6 +107,9 @@ make_huffman_tree_node()
   n->right      = nullptr;
   n->ascii_code = '\0';
   n->leaf_node  = false;
+  n->eos        = false;
+  n->accept     = false;
+  n->state      = 0;
   return n;
 }
 
@@ -115,6 +139,7 @@ make_huffman_tree()
     }
     current->ascii_code = i;
     current->leaf_node  = true;
+    current->eos        = (i == countof(huffman_table) - 1);
   }
   return root;
 }
@@ -132,12 +157,80 @@ free_huffman_tree(Node *node)
   ats_free(node);
 }
 
+// Number the internal nodes in pre-order, the root becomes state 0. A node is accepting when it is
+// the root or when the path to it is at most 7 bits all set to 1, i.e. a valid EOS prefix padding.
+static void
+number_huffman_tree(Node *node, Node **states, unsigned &count, unsigned depth, bool all_ones)
+{
+  if (node->leaf_node) {
+    return;
+  }
+  ink_release_assert(count < countof(huffman_decode_table));
+  node->state     = count;
+  node->accept    = depth == 0 || (all_ones && depth <= 7);
+  states[count++] = node;
+  number_huffman_tree(node->left, states, count, depth + 1, false);
+  number_huffman_tree(node->right, states, count, depth + 1, all_ones);
+}
+
+// Walk the tree for every (state, nibble) pair. The shortest code is 5 bits long, so a nibble can
+// complete one symbol at most.
+static void
+build_huffman_decode_table(Node *root)
+{
+  Node *states[countof(huffman_decode_table)];
+  unsigned count = 0;
+
+  number_huffman_tree(root, states, count, 0, true);
+
+  for (unsigned s = 0; s < count; ++s) {
+    for (unsigned nibble = 0; nibble < 16; ++nibble) {
+      huffman_decode_entry &entry = huffman_decode_table[s][nibble];
+      Node *current               = states[s];
+
+      entry.flags  = 0;
+      entry.symbol = 0;
+      for (int bit = 3; bit >= 0; --bit) {
+        current = (nibble & (1 << bit)) ? current->right : current->left;
+        if (current->leaf_node) {
+          if (current->eos) {
+            entry.flags = HUFFMAN_DECODE_FAIL;
+            break;
+          }
+          entry.flags |= HUFFMAN_DECODE_SYMBOL;
+          entry.symbol = current->ascii_code;
+          current      = root;
+        }
+      }
+      if (entry.flags & HUFFMAN_DECODE_FAIL) {
+        entry.state = 0;
+      } else {
+        entry.state = current->state;
+        if (current->accept) {
+          entry.flags |= HUFFMAN_DECODE_ACCEPT;
+        }
+      }
+    }
+  }
+}
+
 void
 hpack_huffman_init()
 {
-  if (!HUFFMAN_TREE_ROOT) {
-    HUFFMAN_TREE_ROOT = make_huffman_tree();
+  if (huffman_decode_table_ready) {
+    return;
   }
+
+  Node *root = make_huffman_tree();
+  build_huffman_decode_table(root);
+  huffman_decode_table_ready = true;
+
+#ifdef HUFFMAN_TREE_DECODER
+  HUFFMAN_TREE_ROOT = root;
+#else
+  // The state machine does not need the tree anymore.
+  free_huffman_tree(root);
+#endif
 }
 
 void
@@ -145,9 +238,13 @@ hpack_huffman_fin()
 {
   if (HUFFMAN_TREE_ROOT) {
     free_huffman_tree(HUFFMAN_TREE_ROOT);
+    HUFFMAN_TREE_ROOT = nullptr;
   }
+  huffman_decode_table_ready = false;
 }
 
+#ifdef HUFFMAN_TREE_DECODER
+
 int64_t
 huffman_decode(char *dst_start, const uint8_t *src, uint32_t src_len)
 {
@@ -194,6 +291,46 @@ huffman_decode(char *dst_start, const uint8_t *src, uint32_t src_len)
   return dst_end - dst_start;
 }
 
+#else
+
+int64_t
+huffman_decode(char *dst_start, const uint8_t *src, uint32_t src_len)
+{
+  char *dst_end      = dst_start;
+  const uint8_t *end = src + src_len;
+  uint8_t state      = 0;
+  uint8_t flags      = HUFFMAN_DECODE_ACCEPT;
+
+  for (; src < end; ++src) {
+    const huffman_decode_entry *high = &huffman_decode_table[state][*src >> 4];
+    if (high->flags & HUFFMAN_DECODE_FAIL) {
+      return -1;
+    }
+    if (high->flags & HUFFMAN_DECODE_SYMBOL) {
+      *dst_end++ = high->symbol;
+    }
+
+    const huffman_decode_entry *low = &huffman_decode_table[high->state][*src & 0x0f];
+    if (low->flags & HUFFMAN_DECODE_FAIL) {
+      return -1;
+    }
+    if (low->flags & HUFFMAN_DECODE_SYMBOL) {
+      *dst_end++ = low->symbol;
+    }
+    state = low->state;
+    flags = low->flags;
+  }
+
+  // RFC 7541 5.2: the padding must be the most significant bits of EOS and strictly shorter than 8 bits.
+  if (!(flags & HUFFMAN_DECODE_ACCEPT)) {
+    return -1;
+  }
+
+  return dst_end - dst_start;
+}
+
+#endif
+
 uint8_t *
 huffman_encode_append(uint8_t *dst, uint32_t src, int n = 0)
 {
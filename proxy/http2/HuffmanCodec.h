@@ -26,6 +26,9 @@
 #include <cstddef>
 #include <cstdint>
 
+// Strings are decoded with a 4 bit per step state machine built by hpack_huffman_init(). Define
+// HUFFMAN_TREE_DECODER to go back to walking the Huffman tree one bit at a time.
+
 void hpack_huffman_init();
 void hpack_huffman_fin();
 int64_t huffman_decode(char *dst_start, const uint8_t *src, uint32_t src_len);
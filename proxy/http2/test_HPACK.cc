@@ -27,6 +27,7 @@
 #include <sys/stat.h>
 #include <dirent.h>
 #include <string>
+#include <chrono>
 #include <iostream>
 #include <fstream>
 #include "ts/ink_args.h"
@@ -391,6 +392,64 @@ REGRESSION_TEST(HPACK_Encoding)(RegressionTest *t, int /* atype ATS_UNUSED */, i
   }
 }
 
+// A response with many headers, the ones without a value change with each response
+static const char *const BENCHMARK_HEADERS[][2] = {{":status", "200"},
+                                                   {"accept-ranges", "bytes"},
+                                                   {"access-control-allow-origin", "*"},
+                                                   {"age", nullptr},
+                                                   {"cache-control", "public, max-age=3600"},
+                                                   {"content-encoding", "gzip"},
+                                                   {"content-length", nullptr},
+                                                   {"content-type", "text/html; charset=utf-8"},
+                                                   {"date", nullptr},
+                                                   {"etag", nullptr},
+                                                   {"expires", "Thu, 01 Jan 2037 00:00:00 GMT"},
+                                                   {"last-modified", "Mon, 01 Jan 2018 00:00:00 GMT"},
+                                                   {"server", "ATS"},
+                                                   {"set-cookie", nullptr},
+                                                   {"strict-transport-security", "max-age=31536000; includeSubDomains"},
+                                                   {"vary", "Accept-Encoding"},
+                                                   {"via", "https/1.1 cache (ApacheTrafficServer)"},
+                                                   {"x-cache", "HIT"},
+                                                   {"x-content-type-options", "nosniff"},
+                                                   {"x-frame-options", "SAMEORIGIN"},
+                                                   {"x-request-id", nullptr},
+                                                   {"x-served-by", "cache-1"},
+                                                   {"x-timer", nullptr},
+                                                   {"x-xss-protection", "1; mode=block"}};
+
+void
+encode_benchmark()
+{
+  const int rounds          = 20000;
+  const uint32_t table_size = 65536;
+  HpackIndexingTable indexing_table(table_size);
+  uint8_t encoded[8192];
+  size_t encoded_bytes = 0;
+
+  auto start = chrono::steady_clock::now();
+  for (int round = 0; round < rounds; ++round) {
+    string value = to_string(round);
+    HTTPHdr hdr;
+
+    hdr.create(HTTP_TYPE_RESPONSE);
+    for (auto &header : BENCHMARK_HEADERS) {
+      MIMEField *field = hdr.field_create(header[0], strlen(header[0]));
+      const char *v    = header[1] ? header[1] : value.c_str();
+      field->value_set(hdr.m_heap, hdr.m_mime, v, strlen(v));
+      hdr.field_attach(field);
+    }
+    int64_t written = hpack_encode_header_block(indexing_table, encoded, sizeof(encoded), &hdr);
+    ink_release_assert(written > 0);
+    encoded_bytes += written;
+    hdr.destroy();
+  }
+  int64_t usec = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+  cout << "hpack_encode_header_block: " << rounds << " blocks of " << countof(BENCHMARK_HEADERS) << " headers, " << encoded_bytes
+       << " bytes in " << usec << " usec, " << (usec ? static_cast<double>(rounds) * 1000000 / usec : 0) << " blocks/s" << endl;
+}
+
 int
 main(int argc, const char **argv)
 {
@@ -422,6 +481,7 @@ main(int argc, const char **argv)
 
   prepare();
   int status = RegressionTest::main(argc, argv, REGRESSION_TEST_QUICK);
+  encode_benchmark();
 
   hpack_huffman_fin();
   return status;
@@ -24,6 +24,7 @@
 #include <iostream>
 #include <cstring>
 #include <sstream>
+#include <chrono>
 
 #include "ts/TestBox.h"
 
@@ -600,13 +601,13 @@ REGRESSION_TEST(Http2DependencyTree_reprioritize_2)(RegressionTest *t, int /* at
   Node *node_d = tree->find(7);
 
   tree->activate(node_b);
-  box.check(node_x->queue->in(node_a->entry), "A should be in x's queue");
+  box.check(node_x->in_queue(node_a), "A should be in x's queue");
 
   tree->reprioritize(1, 7, true);
 
-  box.check(!node_x->queue->in(node_a->entry), "A should not be in x's queue");
-  box.check(node_x->queue->in(node_d->entry), "D should be in x's queue");
-  box.check(node_d->queue->in(node_a->entry), "A should be in d's queue");
+  box.check(!node_x->in_queue(node_a), "A should not be in x's queue");
+  box.check(node_x->in_queue(node_d), "D should be in x's queue");
+  box.check(node_d->in_queue(node_a), "A should be in d's queue");
 
   delete tree;
 }
@@ -648,11 +649,11 @@ REGRESSION_TEST(Http2DependencyTree_reprioritize_3)(RegressionTest *t, int /* at
   tree->activate(node_f);
   tree->reprioritize(1, 7, true);
 
-  box.check(node_a->queue->in(node_f->entry), "F should be in A's queue");
-  box.check(node_d->queue->in(node_a->entry), "A should be in D's queue");
-  box.check(node_x->queue->in(node_d->entry), "D should be in x's queue");
-  box.check(!node_a->queue->in(node_c->entry), "C should not be in A's queue");
-  box.check(node_c->queue->empty(), "C's queue should be empty");
+  box.check(node_a->in_queue(node_f), "F should be in A's queue");
+  box.check(node_d->in_queue(node_a), "A should be in D's queue");
+  box.check(node_x->in_queue(node_d), "D should be in x's queue");
+  box.check(!node_a->in_queue(node_c), "C should not be in A's queue");
+  box.check(node_c->queue.empty(), "C's queue should be empty");
 
   delete tree;
 }
@@ -767,11 +768,106 @@ REGRESSION_TEST(Http2DependencyTree_max_depth)(RegressionTest *t, int /* atype A
   delete tree;
 }
 
+/**
+ * A node which joins late does not take all of the bandwidth until it catches up
+ *
+ *     ROOT
+ *     /  \
+ *    A    B
+ */
+REGRESSION_TEST(Http2DependencyTree_late_join)(RegressionTest *t, int /* atype ATS_UNUSED */, int *pstatus)
+{
+  TestBox box(t, pstatus);
+  box = REGRESSION_TEST_PASSED;
+
+  Tree *tree = new Tree(100);
+  string a("A"), b("B");
+
+  Node *node_a = tree->add(0, 3, 15, false, &a);
+  Node *node_b = tree->add(0, 5, 15, false, &b);
+
+  tree->activate(node_a);
+  for (int i = 0; i < 100; ++i) {
+    tree->update(tree->top(), 16384);
+  }
+
+  tree->activate(node_b);
+
+  ostringstream oss;
+
+  for (int i = 0; i < 6; ++i) {
+    Node *node = tree->top();
+    oss << static_cast<string *>(node->t)->c_str();
+    tree->update(node, 16384);
+  }
+
+  const string expect = "BABABA";
+  box.check(oss.str() == expect, "\nExpect : %s\nActual : %s", expect.c_str(), oss.str().c_str());
+
+  delete tree;
+}
+
+// Frames scheduled a second with streams which all depend on the root (wide) or on the one before
+// them where only the last one is active (deep).
+static void
+schedule_benchmark(const char *name, bool deep)
+{
+  const int streams = 100;
+  const int frames  = 1000000;
+  Tree tree(streams);
+  string s("S");
+
+  for (int i = 1; i <= streams; ++i) {
+    Node *node = tree.add(deep && i > 1 ? i * 2 - 1 : 0, i * 2 + 1, i % 256, false, &s);
+    if (!deep || i == streams) {
+      tree.activate(node);
+    }
+  }
+
+  auto start = chrono::steady_clock::now();
+  for (int i = 0; i < frames; ++i) {
+    tree.update(tree.top(), 16384);
+  }
+  int64_t usec = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+  cout << "Http2DependencyTree " << name << ": " << frames << " frames of " << streams << " streams in " << usec << " usec, "
+       << (usec ? static_cast<double>(frames) * 1000000 / usec : 0) << " frames/s" << endl;
+}
+
+// PRIORITY frames handled a second, each one moves a stream under another one
+static void
+reprioritize_benchmark()
+{
+  const int streams = 100;
+  const int frames  = 1000000;
+  Tree tree(streams);
+  string s("S");
+
+  for (int i = 1; i <= streams; ++i) {
+    tree.activate(tree.add(0, i * 2 + 1, 15, false, &s));
+  }
+
+  auto start = chrono::steady_clock::now();
+  for (int i = 0; i < frames; ++i) {
+    uint32_t id     = (i * 7 % streams) * 2 + 3;
+    uint32_t parent = (i * 13 % streams) * 2 + 3;
+    tree.reprioritize(id, i % 3 && parent != id ? parent : 0, i % 5 == 0);
+  }
+  int64_t usec = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+  cout << "Http2DependencyTree reprioritize: " << frames << " frames of " << streams << " streams in " << usec << " usec, "
+       << (usec ? static_cast<double>(frames) * 1000000 / usec : 0) << " frames/s" << endl;
+}
+
 int
 main(int /* argc ATS_UNUSED */, const char ** /* argv ATS_UNUSED */)
 {
   const char *name = "Http2DependencyTree";
   RegressionTest::run(name, REGRESSION_TEST_QUICK);
 
+  schedule_benchmark("wide", false);
+  schedule_benchmark("deep", true);
+  reprioritize_benchmark();
+
   return RegressionTest::final_status == REGRESSION_TEST_PASSED ? 0 : 1;
 }
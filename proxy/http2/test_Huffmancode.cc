@@ -24,8 +24,14 @@
 #include "HuffmanCodec.h"
 #include <cstdlib>
 #include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
 #include <cassert>
 #include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <dirent.h>
 
 using namespace std;
 
@@ -134,7 +140,14 @@ values_test()
     encoded_mapped.y[2] = encoded.y[1];
     encoded_mapped.y[3] = encoded.y[0];
 
-    int bytes        = huffman_decode(dst_start, encoded_mapped.y, encoded_size);
+    int bytes = huffman_decode(dst_start, encoded_mapped.y, encoded_size);
+#ifndef HUFFMAN_TREE_DECODER
+    // RFC 7541 5.2: a string containing EOS is a decoding error
+    if (i / 2 == 256) {
+      assert(bytes == -1);
+      continue;
+    }
+#endif
     char ascii_value = i / 2;
     assert(dst_start[0] == ascii_value);
     assert(bytes == 1);
@@ -171,8 +184,117 @@ encode_test()
   }
 }
 
+void
+decode_test()
+{
+  for (const auto &i : huffman_encode_test_data) {
+    char *dst           = static_cast<char *>(malloc(i.src_len + 1));
+    int64_t decoded_len = huffman_decode(dst, i.expect, i.expect_len);
+
+    assert(decoded_len == i.src_len);
+    assert(memcmp(i.src, dst, decoded_len) == 0);
+
+    free(dst);
+  }
+}
+
+// NOTE: Padding must be a prefix of EOS (all ones) and shorter than 8 bits.
+const static struct {
+  uint8_t *src;
+  int64_t src_len;
+  int64_t expect_len;
+} huffman_padding_test_data[] = {
+  {(uint8_t *)"\x07", 1, 1},      // "0" + 3 bits of padding
+  {(uint8_t *)"\x00", 1, -1},     // "0" + 3 bits of zero padding
+  {(uint8_t *)"\xff", 1, -1},     // 8 bits of padding
+  {(uint8_t *)"\x07\xff", 2, -1}, // "0" + 11 bits of padding
+  {(uint8_t *)"\xfe", 1, -1},     // incomplete code
+};
+
+void
+padding_test()
+{
+  char dst[8];
+  for (const auto &i : huffman_padding_test_data) {
+    assert(huffman_decode(dst, i.src, i.src_len) == i.expect_len);
+  }
+}
+
+// Collect the header names and values of the hpack-test-case stories, falling back to random printable
+// strings when the corpus is not around.
+static void
+load_corpus(const char *dir_name, vector<string> &strings)
+{
+  DIR *dir = opendir(dir_name);
+
+  if (dir != nullptr) {
+    struct dirent *d;
+    while ((d = readdir(dir)) != nullptr) {
+      if (strncmp(d->d_name, "story_", 6) != 0) {
+        continue;
+      }
+      ifstream ifs(string(dir_name) + "/" + d->d_name);
+      string line;
+      while (getline(ifs, line)) {
+        size_t son = line.find('"');
+        size_t eon = line.find("\": \"");
+        if (son == string::npos || eon == string::npos || line.compare(son, eon - son, "\"wire") == 0) {
+          continue;
+        }
+        size_t eov = line.find_last_of('"');
+        strings.push_back(line.substr(son + 1, eon - son - 1));
+        strings.push_back(line.substr(eon + 4, eov - eon - 4));
+      }
+    }
+    closedir(dir);
+  }
+
+  if (strings.empty()) {
+    for (int i = 0; i < 10000; ++i) {
+      string str(lrand48() % 64 + 1, ' ');
+      for (char &c : str) {
+        c = ' ' + lrand48() % 95;
+      }
+      strings.push_back(str);
+    }
+  }
+}
+
+void
+decode_benchmark(const char *dir_name)
+{
+  const int rounds = 20;
+  vector<string> strings;
+  vector<vector<uint8_t>> encoded;
+  size_t decoded_bytes = 0;
+  size_t max_len       = 0;
+
+  load_corpus(dir_name, strings);
+  for (const string &str : strings) {
+    vector<uint8_t> buf(str.length() * 4 + 4);
+    int64_t len = huffman_encode(buf.data(), reinterpret_cast<const uint8_t *>(str.data()), str.length());
+    buf.resize(len);
+    encoded.push_back(buf);
+    max_len = std::max(max_len, str.length());
+  }
+  vector<char> dst(max_len);
+
+  auto start = chrono::steady_clock::now();
+  for (int round = 0; round < rounds; ++round) {
+    for (size_t i = 0; i < encoded.size(); ++i) {
+      int64_t len = huffman_decode(dst.data(), encoded[i].data(), encoded[i].size());
+      assert(len == static_cast<int64_t>(strings[i].length()));
+      decoded_bytes += len;
+    }
+  }
+  int64_t usec = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+  cout << "huffman_decode: " << encoded.size() << " strings, " << decoded_bytes << " bytes in " << usec << " usec, "
+       << (usec ? static_cast<double>(decoded_bytes) / usec : 0) << " MB/s" << endl;
+}
+
 int
-main()
+main(int argc, const char **argv)
 {
   hpack_huffman_init();
 
@@ -180,6 +302,12 @@ main()
     random_test();
   }
   values_test();
+  decode_test();
+#ifndef HUFFMAN_TREE_DECODER
+  // The tree decoder tolerates a full byte of padding
+  padding_test();
+#endif
+  decode_benchmark(argc > 1 ? argv[1] : "./hpack-tests");
 
   hpack_huffman_fin();
 
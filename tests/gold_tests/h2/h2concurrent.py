@@ -0,0 +1,60 @@
+'''
+'''
+#  Licensed to the Apache Software Foundation (ASF) under one
+#  or more contributor license agreements.  See the NOTICE file
+#  distributed with this work for additional information
+#  regarding copyright ownership.  The ASF licenses this file
+#  to you under the Apache License, Version 2.0 (the
+#  "License"); you may not use this file except in compliance
+#  with the License.  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+from hyper import HTTPConnection
+import hyper
+import argparse
+
+
+def makerequests(port, streams):
+    hyper.tls._context = hyper.tls.init_context()
+    hyper.tls._context.check_hostname = False
+    hyper.tls._context.verify_mode = hyper.compat.ssl.CERT_NONE
+
+    conn = HTTPConnection('localhost:{0}'.format(port), secure=True)
+
+    # Open all of the streams before reading any response, so they are all active on the connection at once
+    request_ids = []
+    for i in range(streams):
+        request_ids.append(conn.request('GET', url='/'))
+
+    # Read the responses in the reverse order, the last streams opened are looked up first
+    ok = 0
+    for req_id in reversed(request_ids):
+        response = conn.get_response(req_id)
+        response.read()
+        if response.status == 200:
+            ok += 1
+    print("{0} streams, {1} responses with status 200".format(streams, ok))
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--port", "-p",
+                        type=int,
+                        help="Port to use")
+    parser.add_argument("--streams", "-s",
+                        type=int,
+                        default=200,
+                        help="Number of concurrent streams")
+    args = parser.parse_args()
+    makerequests(args.port, args.streams)
+
+
+if __name__ == '__main__':
+    main()
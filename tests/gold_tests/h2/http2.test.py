@@ -87,6 +87,7 @@ ts.Setup.CopyAs('h2client.py', Test.RunDirectory)
 ts.Setup.CopyAs('h2bigclient.py', Test.RunDirectory)
 ts.Setup.CopyAs('h2chunked.py', Test.RunDirectory)
 ts.Setup.CopyAs('h2active_timeout.py', Test.RunDirectory)
+ts.Setup.CopyAs('h2concurrent.py', Test.RunDirectory)
 
 # Test Case 1:  basic H2 interaction
 tr = Test.AddTestRun()
@@ -134,3 +135,10 @@ tr.Processes.Default.Command = 'curl -s -k -H "Transfer-Encoding: chunked" -d "{
 tr.Processes.Default.ReturnCode = 0
 tr.Processes.Default.Streams.All = "gold/post_chunked.gold"
 tr.StillRunningAfter = server
+
+# Test Case 7: Many concurrent streams on one connection
+tr = Test.AddTestRun()
+tr.Processes.Default.Command = 'python3 h2concurrent.py -p {0} -s 200'.format(ts.Variables.ssl_port)
+tr.Processes.Default.ReturnCode = 0
+tr.Processes.Default.Streams.stdout = "gold/concurrent.gold"
+tr.StillRunningAfter = server